@@ -0,0 +1,518 @@
+//
+// Copyright (c) 2026
+// Kyle Markley.  All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+// 3. Neither the name of the author nor the names of any contributors may be
+//    used to endorse or promote products derived from this software without
+//    specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include "arr/attribute_traversal.hpp"
+
+#if defined(__linux__)
+
+#include "arr/file_descriptor.hpp"
+#include "arr/memory_map.hpp"
+#include "arr/mman.hpp"
+#include "arr/path_match.hpp"
+#include <sys/sysmacros.h>
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace arr {
+
+namespace {
+
+void fetch_one(statx_request& r, int flags, unsigned mask) noexcept {
+  try {
+    wrap::statx(SOURCE_CONTEXT, r.dir_fd, r.name, flags, mask, r.result);
+    r.error = 0;
+  } catch (syscall_exception& e) {
+    r.error = e.code().value();
+  }
+}
+
+///
+/// Minimal io_uring, using only the statx operation
+///
+/// This uses the system calls directly, so that there is no dependency on
+/// liburing.
+///
+struct uring {
+  uring(unsigned entries);
+  bool supports(unsigned op) const;
+  void fetch(statx_request * requests, std::size_t count,
+      int flags, unsigned mask);
+  unsigned capacity() const noexcept { return sq_entries; }
+private:
+  static unsigned& at(const wrap::memory_map& m, std::uint32_t offset) {
+    return *static_cast<unsigned *>(static_cast<void *>(
+          static_cast<char *>(m.get()) + offset));
+  }
+  static std::atomic_ref<unsigned> atomic(unsigned& u) {
+    return std::atomic_ref<unsigned>(u);
+  }
+  wrap::file_descriptor fd;
+  wrap::memory_map sq_ring;
+  wrap::memory_map cq_ring;
+  wrap::memory_map sqe_map;
+  io_uring_params params;
+  unsigned sq_entries = 0u;
+};
+
+uring::uring(unsigned entries) {
+  std::memset(&params, 0, sizeof(params));
+  auto r = ::syscall(SYS_io_uring_setup, entries, &params);
+  if (-1 == r) throw syscall_exception(SOURCE_CONTEXT, "io_uring_setup");
+  fd = static_cast<int>(r);
+  sq_entries = params.sq_entries;
+
+  auto sq_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+  auto cq_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+  auto map = [&](std::size_t size, off_t offset) {
+    return wrap::memory_map(wrap::mmap(SOURCE_CONTEXT, nullptr, size,
+          PROT_READ|PROT_WRITE, MAP_SHARED|MAP_POPULATE, fd.get(), offset),
+        size);
+  };
+  if (params.features & IORING_FEAT_SINGLE_MMAP) {
+    sq_ring = map(std::max(sq_size, cq_size), IORING_OFF_SQ_RING);
+  } else {
+    sq_ring = map(sq_size, IORING_OFF_SQ_RING);
+    cq_ring = map(cq_size, IORING_OFF_CQ_RING);
+  }
+  sqe_map = map(params.sq_entries * sizeof(io_uring_sqe), IORING_OFF_SQES);
+}
+
+bool uring::supports(unsigned op) const {
+  auto size = sizeof(io_uring_probe) + 256u * sizeof(io_uring_probe_op);
+  std::vector<char> buffer(size);
+  auto probe = static_cast<io_uring_probe *>(
+      static_cast<void *>(buffer.data()));
+  auto r = ::syscall(SYS_io_uring_register,
+      fd.get(), IORING_REGISTER_PROBE, probe, 256u);
+  if (-1 == r) return false;
+  return op <= probe->last_op and (probe->ops[op].flags & IO_URING_OP_SUPPORTED);
+}
+
+void uring::fetch(statx_request * requests, std::size_t count,
+    int flags, unsigned mask) {
+  using enum std::memory_order;
+  auto& cq = cq_ring.valid() ? cq_ring : sq_ring;
+  auto sqes = static_cast<io_uring_sqe *>(sqe_map.get());
+  auto cqes = static_cast<io_uring_cqe *>(static_cast<void *>(
+        static_cast<char *>(cq.get()) + params.cq_off.cqes));
+  auto array = &at(sq_ring, params.sq_off.array);
+  auto sq_mask = at(sq_ring, params.sq_off.ring_mask);
+  auto cq_mask = at(cq, params.cq_off.ring_mask);
+  auto& sq_tail = at(sq_ring, params.sq_off.tail);
+  auto& cq_head = at(cq, params.cq_off.head);
+  auto& cq_tail = at(cq, params.cq_off.tail);
+
+  while (count) {
+    auto n = static_cast<unsigned>(std::min<std::size_t>(count, sq_entries));
+    auto tail = atomic(sq_tail).load(relaxed);
+    for (unsigned i = 0; i < n; ++i) {
+      auto index = (tail + i) & sq_mask;
+      auto& sqe = sqes[index];
+      std::memset(&sqe, 0, sizeof(sqe));
+      sqe.opcode = IORING_OP_STATX;
+      sqe.fd = requests[i].dir_fd;
+      sqe.addr = reinterpret_cast<std::uintptr_t>(requests[i].name);
+      sqe.len = mask;
+      sqe.off = reinterpret_cast<std::uintptr_t>(requests[i].result);
+      sqe.statx_flags = static_cast<std::uint32_t>(flags);
+      sqe.user_data = i;
+      array[index] = index;
+    }
+    atomic(sq_tail).store(tail + n, release);
+
+    unsigned submit = n;
+    unsigned done = 0u;
+    while (done < n) {
+      auto r = ::syscall(SYS_io_uring_enter,
+          fd.get(), submit, 1u, IORING_ENTER_GETEVENTS, nullptr, 0);
+      if (-1 == r) {
+        if (EINTR == errno) continue;
+        throw syscall_exception(SOURCE_CONTEXT, "io_uring_enter");
+      }
+      submit -= static_cast<unsigned>(r);
+      auto head = atomic(cq_head).load(relaxed);
+      auto ready = atomic(cq_tail).load(acquire);
+      for (; head != ready; ++head, ++done) {
+        auto& cqe = cqes[head & cq_mask];
+        requests[cqe.user_data].error = cqe.res < 0 ? -cqe.res : 0;
+      }
+      atomic(cq_head).store(head, release);
+    }
+    requests += n;
+    count -= n;
+  }
+}
+
+///
+/// Pool of threads issuing blocking statx calls
+///
+struct thread_pool {
+  thread_pool(unsigned count, int flags, unsigned mask);
+  ~thread_pool();
+  void fetch(statx_request * requests, std::size_t count);
+private:
+  void work();
+  void run_batch() noexcept;
+  int flags;
+  unsigned mask;
+  std::vector<std::thread> threads;
+  std::mutex lock;
+  std::condition_variable start;
+  std::condition_variable finish;
+  std::uint64_t generation = 0u;
+  unsigned active = 0u;
+  bool quit = false;
+  statx_request * batch = nullptr;
+  std::size_t batch_size = 0u;
+  std::atomic<std::size_t> next {0u};
+};
+
+thread_pool::thread_pool(unsigned count, int f, unsigned m)
+  : flags(f)
+  , mask(m)
+{
+  // The calling thread also works, so it is not counted
+  for (unsigned i = 1; i < count; ++i) threads.emplace_back([this] { work(); });
+}
+
+thread_pool::~thread_pool() {
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    quit = true;
+  }
+  start.notify_all();
+  for (auto& t : threads) t.join();
+}
+
+void thread_pool::run_batch() noexcept {
+  for (;;) {
+    auto i = next.fetch_add(1u, std::memory_order::relaxed);
+    if (i >= batch_size) return;
+    fetch_one(batch[i], flags, mask);
+  }
+}
+
+void thread_pool::work() {
+  std::uint64_t seen = 0u;
+  for (;;) {
+    {
+      std::unique_lock<std::mutex> guard(lock);
+      start.wait(guard, [&] { return quit or generation != seen; });
+      if (quit) return;
+      seen = generation;
+    }
+    run_batch();
+    {
+      std::lock_guard<std::mutex> guard(lock);
+      --active;
+    }
+    finish.notify_one();
+  }
+}
+
+void thread_pool::fetch(statx_request * requests, std::size_t count) {
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    batch = requests;
+    batch_size = count;
+    next.store(0u, std::memory_order::relaxed);
+    active = static_cast<unsigned>(threads.size());
+    ++generation;
+  }
+  start.notify_all();
+  run_batch();
+  std::unique_lock<std::mutex> guard(lock);
+  finish.wait(guard, [&] { return 0u == active; });
+}
+
+}
+
+struct statx_batch::implementation {
+  int flags;
+  unsigned mask;
+  statx_engine engine;
+  std::unique_ptr<uring> ring;
+  std::unique_ptr<thread_pool> pool;
+};
+
+statx_batch::statx_batch(
+    unsigned mask,
+    int flags,
+    std::size_t depth,
+    statx_engine engine,
+    unsigned threads)
+  : _impl(new implementation{flags, mask, engine, nullptr, nullptr})
+{
+  auto entries = static_cast<unsigned>(
+      std::clamp<std::size_t>(depth, 1u, 4096u));
+  if (statx_engine::io_uring == engine or statx_engine::automatic == engine) {
+    try {
+      _impl->ring.reset(new uring(entries));
+      if (not _impl->ring->supports(IORING_OP_STATX)) {
+        _impl->ring.reset();
+        throw syscall_exception(SOURCE_CONTEXT, "io_uring_register", ENOSYS);
+      }
+      _impl->engine = statx_engine::io_uring;
+    } catch (syscall_exception&) {
+      if (statx_engine::io_uring == engine) throw;
+      _impl->engine = statx_engine::threads;
+    }
+  }
+  if (statx_engine::threads == _impl->engine) {
+    if (0u == threads) {
+      threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    _impl->pool.reset(new thread_pool(threads, flags, mask));
+  }
+}
+
+statx_batch::~statx_batch() = default;
+
+statx_engine statx_batch::engine() const noexcept { return _impl->engine; }
+
+void statx_batch::fetch(statx_request * requests, std::size_t count) {
+  switch (_impl->engine) {
+    case statx_engine::io_uring:
+      _impl->ring->fetch(requests, count, _impl->flags, _impl->mask);
+      break;
+    case statx_engine::threads:
+      _impl->pool->fetch(requests, count);
+      break;
+    case statx_engine::automatic:
+    case statx_engine::serial:
+      for (std::size_t i = 0; i < count; ++i) {
+        fetch_one(requests[i], _impl->flags, _impl->mask);
+      }
+      break;
+  }
+}
+
+attribute_traversal::attribute_traversal(
+    std::string directory,
+    attribute_options options)
+  : _root(std::move(directory))
+  , _options(std::move(options))
+  , _fetcher(_options.mask | STATX_TYPE
+      | (_options.rules.unique_files ? STATX_NLINK | STATX_INO : 0u),
+      AT_SYMLINK_NOFOLLOW, std::max<std::size_t>(1u, _options.batch),
+      _options.engine, _options.threads)
+  , _files(_options.rules.max_inode_table)
+{
+  if (_options.rules.follow_symlinks) {
+    throw std::invalid_argument(
+        "attribute_traversal does not follow symbolic links");
+  }
+  if (not _options.rules.resume_after.empty()) {
+    throw std::invalid_argument("attribute_traversal cannot resume");
+  }
+  _options.batch = std::max<std::size_t>(1u, _options.batch);
+}
+
+attribute_traversal::frame::frame(
+    std::string path,
+    const directory_options& options,
+    std::size_t entry_depth)
+  : ds(std::move(path), options)
+  , iter(ds.begin())
+  , depth(entry_depth)
+{ }
+
+attribute_traversal::frame::frame(const frame& parent, const item& subdir)
+  : ds(parent.iter.dir_fd(), subdir.name, parent.ds.path() + subdir.name,
+      parent.ds.options())
+  , iter(ds.begin())
+  , depth(parent.depth + 1u)
+{ }
+
+void attribute_traversal::run(visitor_type visitor) {
+  _stack.clear();
+  _pending.clear();
+  _stack.emplace_back(_root, _options.directory, 1u);
+  auto& root = _stack.back();
+  _root_length = root.ds.path().size();
+  if (_options.rules.one_filesystem and root.iter != root.ds.end()) {
+    try {
+      struct stat sb;
+      wrap::fstat(SOURCE_CONTEXT, root.iter.dir_fd(), &sb);
+      _device = sb.st_dev;
+    } catch (syscall_exception& e) {
+      exceptions.emplace_back(e.clone());
+    }
+  }
+  std::vector<item> batch;
+  batch.reserve(_options.batch);
+  for (;;) {
+    if (_stack.empty()) {
+      if (_pending.empty()) break;
+      auto [path, depth] = std::move(_pending.front());
+      _pending.pop_front();
+      _stack.emplace_back(std::move(path), _options.directory, depth);
+    }
+    auto& f = _stack.back();
+    if (not f.subdirs.empty()) {
+      _stack.emplace_back(f, f.subdirs.front());
+    } else if (f.iter != f.ds.end()) {
+      read(f, batch);
+      flush(f, batch, visitor);
+    } else {
+      leave(visitor);
+    }
+  }
+}
+
+void attribute_traversal::read(frame& f, std::vector<item>& batch) {
+  for (; f.iter != f.ds.end() and batch.size() < _options.batch; ++f.iter) {
+    batch.push_back(item{f.iter->d_name, f.iter->d_type, {}, 0});
+  }
+}
+
+void attribute_traversal::flush(frame& f, std::vector<item>& batch,
+    visitor_type& visitor) {
+  std::vector<statx_request> requests;
+  requests.reserve(batch.size());
+  int dir_fd = f.iter.dir_fd();
+  for (auto& b : batch) {
+    requests.push_back({dir_fd, b.name.c_str(), &b.attributes, 0});
+  }
+  _fetcher.fetch(requests.data(), requests.size());
+  for (std::size_t n = 0; n < batch.size(); ++n) {
+    auto& b = batch[n];
+    b.error = requests[n].error;
+    if (DT_UNKNOWN == b.type and 0 == b.error) {
+      b.type = static_cast<unsigned char>(IFTODT(b.attributes.stx_mode));
+    }
+    bool descend = descends(f, b);
+    // In post-order, a directory descended into is visited on leaving it
+    if ((not descend or dir_order::post != _options.order) and visits(f, b)) {
+      visitor(attributed_entry{
+          f.ds, b.name.c_str(), b.type, dir_fd, b.attributes, b.error});
+    }
+    if (not descend) continue;
+    if (dir_order::breadth == _options.order) {
+      _pending.emplace_back(f.ds.path() + b.name, f.depth + 1u);
+    } else {
+      f.subdirs.push_back(std::move(b));
+    }
+  }
+  batch.clear();
+}
+
+void attribute_traversal::leave(visitor_type& visitor) {
+  exceptions.splice(exceptions.end(), _stack.back().ds.exceptions);
+  _stack.pop_back();
+  if (_stack.empty()) return;
+  auto& parent = _stack.back();
+  if (parent.subdirs.empty()) return;
+  auto& subdir = parent.subdirs.front();
+  if (dir_order::post == _options.order and visits(parent, subdir)) {
+    visitor(attributed_entry{parent.ds, subdir.name.c_str(), subdir.type,
+        parent.iter.dir_fd(), subdir.attributes, subdir.error});
+  }
+  parent.subdirs.pop_front();
+}
+
+bool attribute_traversal::visits(const frame& f, const item& entry) {
+  using visit_type = recursive_directory_sequence::visit_type;
+  switch (_options.visit) {
+    case visit_type::all:
+      break;
+    case visit_type::directory:
+      if (DT_DIR != entry.type) return false;
+      break;
+    case visit_type::file:
+      if (DT_REG != entry.type) return false;
+      break;
+    case visit_type::link:
+      if (DT_LNK != entry.type) return false;
+      break;
+    case visit_type::non_dir:
+      if (DT_DIR == entry.type) return false;
+      break;
+  }
+  auto& rules = _options.rules;
+  if (not rules.include.empty() and not matches(rules.include, f, entry)) {
+    return false;
+  }
+  if (matches(rules.exclude, f, entry)) return false;
+  if (rules.unique_files and DT_DIR != entry.type and 0 == entry.error and
+      entry.attributes.stx_nlink > 1 and
+      not _files.insert(makedev(entry.attributes.stx_dev_major,
+          entry.attributes.stx_dev_minor), entry.attributes.stx_ino)) {
+    return false;
+  }
+  return true;
+}
+
+bool attribute_traversal::descends(const frame& f, const item& entry) const {
+  auto& rules = _options.rules;
+  if (DT_DIR != entry.type) return false;
+  if (f.depth >= rules.max_depth) return false;
+  if (matches(rules.exclude, f, entry)) return false;
+  if (rules.one_filesystem) {
+    // The filesystem of an entry whose attributes are missing is unknown
+    if (entry.error) return false;
+    if (_device != makedev(entry.attributes.stx_dev_major,
+          entry.attributes.stx_dev_minor)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool attribute_traversal::matches(
+    const std::vector<std::string>& patterns,
+    const frame& f, const item& entry) const {
+  std::string relative;
+  for (auto& pattern : patterns) {
+    if (std::string::npos == pattern.find('/')) {
+      if (path_match(pattern, entry.name)) return true;
+    } else {
+      if (relative.empty()) {
+        relative = (f.ds.path() + entry.name).substr(_root_length);
+      }
+      if (path_match(pattern, relative)) return true;
+    }
+  }
+  return false;
+}
+
+}
+
+#endif
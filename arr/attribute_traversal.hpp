@@ -0,0 +1,237 @@
+#ifndef ARR_ATTRIBUTE_TRAVERSAL_HPP
+#define ARR_ATTRIBUTE_TRAVERSAL_HPP
+//
+// Copyright (c) 2026
+// Kyle Markley.  All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+// 3. Neither the name of the author nor the names of any contributors may be
+//    used to endorse or promote products derived from this software without
+//    specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include "arr/recursive_directory_sequence.hpp"
+#include "arr/fcntl.hpp"
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <list>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+
+namespace arr {
+
+/// \addtogroup directory_traversal
+/// @{
+
+///
+/// Method of issuing statx calls in a batch
+///
+enum class statx_engine {
+  automatic,    ///< io_uring if available, otherwise threads
+  io_uring,     ///< Asynchronous submission through io_uring
+  threads,      ///< Blocking calls spread over a pool of threads
+  serial,       ///< Blocking calls from the calling thread
+};
+
+///
+/// One statx call of a batch
+///
+struct statx_request {
+  int dir_fd;                   ///< Directory to which \c name is relative
+  const char * name;            ///< Name of the file
+  struct statx * result;        ///< Destination of the attributes
+  int error;                    ///< Set to an errno value, or zero
+};
+
+///
+/// Issuer of batches of statx calls
+///
+/// With io_uring, a batch is submitted with one system call and its
+/// completions are reaped together, so the kernel may service the requests
+/// concurrently.  If io_uring or its statx operation is unavailable, the
+/// calls are instead spread over a pool of threads.
+///
+struct statx_batch {
+  ///
+  /// Construct a statx_batch
+  ///
+  /// @param mask    Attributes requested (\c STATX_* flags)
+  /// @param flags   Flags of each call (\c AT_* flags)
+  /// @param depth   Most requests in flight at once
+  /// @param engine  Method of issuing the calls
+  /// @param threads Number of threads for \c statx_engine::threads
+  ///                (0 for the number of CPUs)
+  ///
+  /// Throws \c syscall_exception if \c statx_engine::io_uring is requested
+  /// but unavailable.
+  ///
+  statx_batch(
+      unsigned mask,
+      int flags = AT_SYMLINK_NOFOLLOW,
+      std::size_t depth = 256u,
+      statx_engine engine = statx_engine::automatic,
+      unsigned threads = 0u);
+  ~statx_batch();
+  statx_batch(const statx_batch& ) = delete;
+  statx_batch(      statx_batch&&) = delete;
+  statx_batch& operator=(const statx_batch& ) = delete;
+  statx_batch& operator=(      statx_batch&&) = delete;
+
+  ///
+  /// Complete every request of a batch
+  ///
+  /// Failure of an individual call is reported in its \c error.
+  ///
+  void fetch(statx_request * requests, std::size_t count);
+
+  /// Method in use, never \c statx_engine::automatic
+  statx_engine engine() const noexcept;
+
+  struct implementation;
+private:
+  std::unique_ptr<implementation> _impl;
+};
+
+///
+/// Options for an attribute_traversal
+///
+struct attribute_options {
+  unsigned mask = STATX_BASIC_STATS;    ///< Attributes requested
+  std::size_t batch = 256u;             ///< Entries fetched at once
+  statx_engine engine = statx_engine::automatic;
+  unsigned threads = 0u;                ///< Threads of the thread engine
+  recursive_directory_sequence::dir_order order
+    = recursive_directory_sequence::dir_order::pre;
+  recursive_directory_sequence::visit_type visit
+    = recursive_directory_sequence::visit_type::all;
+  directory_options directory = {};     ///< Options for reading directories
+  traversal_options rules = {};         ///< Pruning of the traversal
+};
+
+///
+/// Entry visited by an attribute_traversal
+///
+struct attributed_entry {
+  const directory_sequence& directory;  ///< Directory containing the entry
+  const char * name;                    ///< Name of the entry
+  unsigned char type;                   ///< Type, as \c dirent::d_type
+  int dir_fd;                           ///< Descriptor of \c directory
+  const struct statx& attributes;       ///< Attributes, unless \c error
+  int error;                            ///< errno value of statx, or zero
+
+  /// Path of the entry
+  std::string path() const { return directory.path() + name; }
+};
+
+///
+/// Recursive directory traversal yielding entries with their attributes
+///
+/// Entries of each directory are gathered in batches, whose attributes are
+/// fetched together by a \c statx_batch relative to the directory's
+/// descriptor before the entries are visited.  The subdirectories of a batch
+/// are descended into once the whole batch has been visited, so the order
+/// is that of a recursive_directory_sequence except that the entries of a
+/// batch are visited together.  Open directories are kept on a stack rather
+/// than by recursion.
+///
+/// The type of an entry whose \c d_type is \c DT_UNKNOWN is taken from its
+/// attributes, so \c visit_type filtering and descent work on filesystems
+/// that do not provide \c d_type.
+///
+/// Of the \c traversal_options, \c include, \c exclude, \c max_depth,
+/// \c one_filesystem and \c unique_files are honoured.  Attributes describe
+/// an entry itself rather than the target of a symbolic link, so the
+/// constructor throws \c std::invalid_argument if \c follow_symlinks or
+/// \c resume_after is given.
+///
+struct attribute_traversal {
+  using visitor_type = std::function<void(const attributed_entry&)>;
+
+  attribute_traversal(std::string directory, attribute_options options = {});
+
+  ///
+  /// Visit every entry below the root
+  ///
+  /// @param visitor Called as \c visitor(entry) for each entry
+  ///
+  void run(visitor_type visitor);
+
+  const std::string& root() const noexcept { return _root; }
+
+  /// Method in use for fetching attributes
+  statx_engine engine() const noexcept { return _fetcher.engine(); }
+
+  ///
+  /// Exceptions encountered during directory traversal
+  ///
+  std::list<std::unique_ptr<syscall_exception>> exceptions;
+
+private:
+  /// Entry waiting for its attributes
+  struct item {
+    std::string name;
+    unsigned char type;
+    struct statx attributes;
+    int error;
+  };
+  /// Directory being read
+  struct frame {
+    frame(std::string path, const directory_options& options,
+        std::size_t depth);
+    frame(const frame& parent, const item& subdir);
+    directory_sequence ds;
+    directory_iterator iter;
+    std::size_t depth;          ///< Depth of the directory's entries
+    std::deque<item> subdirs;   ///< Of the last batch, to be descended into
+  };
+  void read(frame& f, std::vector<item>& batch);
+  void flush(frame& f, std::vector<item>& batch, visitor_type& visitor);
+  void leave(visitor_type& visitor);
+  bool visits(const frame& f, const item& entry);
+  bool descends(const frame& f, const item& entry) const;
+  bool matches(const std::vector<std::string>& patterns,
+      const frame& f, const item& entry) const;
+
+  using dir_order = recursive_directory_sequence::dir_order;
+  std::string _root;
+  attribute_options _options;
+  statx_batch _fetcher;
+  std::deque<frame> _stack;     ///< Open directories, deepest last
+  std::deque<std::pair<std::string, std::size_t>> _pending;
+                                ///< Directories and depths, if breadth-first
+  std::size_t _root_length = 0; ///< Length of the root's path
+  dev_t _device = 0;            ///< Filesystem of the root
+  inode_set _files;             ///< Files with several links, if unique
+};
+
+/// @}
+
+}
+
+#endif
+
+#endif
@@ -0,0 +1,229 @@
+//
+// Copyright (c) 2026
+// Kyle Markley.  All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+// 3. Neither the name of the author nor the names of any contributors may be
+//    used to endorse or promote products derived from this software without
+//    specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include "arrtest/arrtest.hpp"
+#include "arr/attribute_traversal.hpp"
+#include "arr/file_descriptor.hpp"
+#include "arr/temp_dir.hpp"
+#include "arr/unistd.hpp"
+#include <iostream>
+#include <algorithm>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+UNIT_TEST_MAIN
+
+#if defined(__linux__)
+
+using namespace arr;
+using namespace std;
+
+namespace {
+
+// Files of sizes 0..n-1 under the root and a subdirectory
+void build_tree(const string& root, int n) {
+  auto sub = root + "/sub";
+  wrap::mkdir(SOURCE_CONTEXT, sub.c_str(), 0700);
+  for (auto dir : { root, sub }) {
+    for (int i = 0; i < n; ++i) {
+      auto file = dir + "/f" + to_string(i);
+      wrap::file_descriptor fd = wrap::open(SOURCE_CONTEXT,
+          file.c_str(), O_WRONLY|O_CREAT, 0600);
+      string data(static_cast<size_t>(i), 'x');
+      if (i) wrap::write(SOURCE_CONTEXT, fd.get(), data.data(), data.size());
+    }
+  }
+}
+
+map<string, long long> sizes(const string& root, statx_engine engine,
+    size_t batch) {
+  map<string, long long> result;
+  attribute_traversal at(root, { .mask = STATX_SIZE, .batch = batch,
+      .engine = engine, .threads = 3u,
+      .visit = recursive_directory_sequence::visit_type::file });
+  at.run([&](const attributed_entry& e) {
+    result[e.path()] = e.error ? -1 : static_cast<long long>(e.attributes.stx_size);
+  });
+  return result;
+}
+
+// Paths visited by an attribute_traversal
+vector<string> walk(const string& root, attribute_options options) {
+  vector<string> result;
+  attribute_traversal at(root, std::move(options));
+  at.run([&](const attributed_entry& e) { result.push_back(e.path()); });
+  return result;
+}
+
+// Paths visited by a recursive_directory_sequence
+vector<string> expected(const string& root,
+    recursive_directory_sequence::dir_order order,
+    traversal_options rules = {}) {
+  vector<string> result;
+  recursive_directory_sequence rds(root, order,
+      recursive_directory_sequence::visit_type::all, {}, std::move(rules));
+  for (auto i = rds.begin(); i != rds.end(); ++i) {
+    result.emplace_back(rds.full_path());
+  }
+  return result;
+}
+
+// Nested directories with files at each level
+void build_nested(const string& root) {
+  build_tree(root, 3);
+  auto deep = root + "/sub/deep";
+  wrap::mkdir(SOURCE_CONTEXT, deep.c_str(), 0700);
+  build_tree(deep, 2);
+  wrap::mkdir(SOURCE_CONTEXT, (root + "/empty").c_str(), 0700);
+}
+
+}
+
+SUITE(engines) {
+
+  TEST(all_agree) {
+    temp_dir t;
+    build_tree(t.name(), 20);
+    auto expected = sizes(t.name(), statx_engine::serial, 7u);
+    CHECK_EQUAL(40u, expected.size());
+    CHECK_EQUAL(19, expected[string(t.name()) + "/sub/f19"]);
+    for (auto engine : { statx_engine::automatic, statx_engine::threads }) {
+      CHECK_EQUAL(true, expected == sizes(t.name(), engine, 7u));
+      CHECK_EQUAL(true, expected == sizes(t.name(), engine, 1000u));
+    }
+  }
+
+  TEST(selected) {
+    statx_batch automatic(STATX_SIZE);
+    cout << "Automatic statx engine: "
+      << (statx_engine::io_uring == automatic.engine() ? "io_uring" : "threads")
+      << endl;
+    CHECK_EQUAL(true, statx_engine::automatic != automatic.engine());
+    statx_batch threads(STATX_SIZE, AT_SYMLINK_NOFOLLOW, 16u,
+        statx_engine::threads);
+    CHECK_EQUAL(true, statx_engine::threads == threads.engine());
+  }
+
+  TEST(errors) {
+    temp_dir t;
+    statx_batch b(STATX_SIZE, AT_SYMLINK_NOFOLLOW, 4u, statx_engine::threads);
+    struct statx result;
+    statx_request r[] = {
+      { AT_FDCWD, t.name(), &result, -1 },
+      { AT_FDCWD, "/nonexistent/file", &result, 0 },
+    };
+    b.fetch(r, 2u);
+    CHECK_EQUAL(0, r[0].error);
+    CHECK_EQUAL(ENOENT, r[1].error);
+  }
+
+}
+
+SUITE(traversal) {
+
+  using dir_order = recursive_directory_sequence::dir_order;
+
+  TEST(order) {
+    temp_dir t;
+    build_nested(t.name());
+    for (auto order : {dir_order::pre, dir_order::post, dir_order::breadth}) {
+      // One entry per batch visits in the order of a
+      // recursive_directory_sequence
+      auto single = walk(t.name(), { .batch = 1u, .order = order });
+      CHECK_EQUAL(true, expected(t.name(), order) == single);
+      auto batched = walk(t.name(), { .batch = 1000u, .order = order });
+      CHECK_EQUAL(single.size(), batched.size());
+      auto position = [&](const string& path) {
+        return find(batched.begin(), batched.end(), path) - batched.begin();
+      };
+      auto sub = string(t.name()) + "/sub";
+      auto inside = position(sub + "/f0");
+      if (dir_order::post == order) {
+        CHECK_EQUAL(true, position(sub) > inside);
+      } else {
+        CHECK_EQUAL(true, position(sub) < inside);
+      }
+      sort(single.begin(), single.end());
+      sort(batched.begin(), batched.end());
+      CHECK_EQUAL(true, single == batched);
+    }
+  }
+
+  TEST(rules) {
+    temp_dir t;
+    build_nested(t.name());
+    vector<traversal_options> cases(5u);
+    cases[0].include = { "f1" };
+    cases[1].exclude = { "deep" };
+    cases[2].exclude = { "sub/f*" };
+    cases[3].max_depth = 2u;
+    cases[4].one_filesystem = true;
+    for (auto& rules : cases) {
+      for (auto order : { dir_order::pre, dir_order::post }) {
+        auto visited = walk(t.name(),
+            { .batch = 1u, .order = order, .rules = rules });
+        CHECK_EQUAL(true, expected(t.name(), order, rules) == visited);
+      }
+    }
+    attribute_options shallow;
+    shallow.rules.max_depth = 1u;
+    CHECK_EQUAL(5u, walk(t.name(), shallow).size());
+  }
+
+  TEST(unique_files) {
+    temp_dir t;
+    build_tree(t.name(), 2);
+    auto link = string(t.name()) + "/link";
+    CHECK_EQUAL(0, ::link((string(t.name()) + "/f1").c_str(), link.c_str()));
+    attribute_options unique;
+    unique.rules.unique_files = true;
+    CHECK_EQUAL(walk(t.name(), {}).size() - 1u, walk(t.name(), unique).size());
+  }
+
+  TEST(unsupported) {
+    temp_dir t;
+    attribute_options follow;
+    follow.rules.follow_symlinks = true;
+    try {
+      attribute_traversal at(t.name(), follow);
+      CHECK_CATCH(std::invalid_argument, e);
+    }
+    attribute_options resume;
+    resume.rules.resume_after = "f0";
+    try {
+      attribute_traversal at(t.name(), resume);
+      CHECK_CATCH(std::invalid_argument, e);
+    }
+  }
+
+}
+
+#endif
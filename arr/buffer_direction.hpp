@@ -1,7 +1,7 @@
 #ifndef ARR_BUFFER_DIRECTION_HPP
 #define ARR_BUFFER_DIRECTION_HPP
 //
-// Copyright (c) 2013, 2021, 2023
+// Copyright (c) 2013, 2021, 2023, 2026
 // Kyle Markley.  All rights reserved.
 //
 // Redistribution and use in source and binary forms, with or without
@@ -48,6 +48,15 @@ struct buffer_direction : private recent_accumulator<T> {
 
   constexpr buffer_direction() noexcept : _offset(0u) { }
 
+  ///
+  /// Resume tracking from a previously observed total
+  ///
+  /// @param previous Total number of elements already transferred
+  /// @param wrap     Offset at which the buffer wraps
+  ///
+  constexpr buffer_direction(size_type previous, size_type wrap) noexcept
+    : base(previous), _offset(previous % wrap) { }
+
   using base::total;
   using base::recent;
   using base::reset_recent;
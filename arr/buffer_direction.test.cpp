@@ -1,5 +1,5 @@
 //
-// Copyright (c) 2013, 2021, 2023
+// Copyright (c) 2013, 2021, 2023, 2026
 // Kyle Markley.  All rights reserved.
 //
 // Redistribution and use in source and binary forms, with or without
@@ -43,6 +43,16 @@ SUITE(base) {
     CHECK_EQUAL(0u, d.offset());
   }
 
+  TEST(resume) {
+    arr::buffer_direction<unsigned> d(13u, 6u);
+    CHECK_EQUAL(13u, d.total());
+    CHECK_EQUAL( 0u, d.recent());
+    CHECK_EQUAL( 1u, d.offset());
+    d.increase_weak(5u, 6u, all);
+    CHECK_EQUAL(18u, d.total());
+    CHECK_EQUAL( 0u, d.offset());
+  }
+
   TEST(increase_weak) {
     arr::buffer_direction<unsigned> d;
     d.increase_weak(5u, 6u, all);
@@ -0,0 +1,147 @@
+#ifndef ARR_DIRECTORY_ERROR_LOG_HPP
+#define ARR_DIRECTORY_ERROR_LOG_HPP
+//
+// Copyright (c) 2026
+// Kyle Markley.  All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+// 3. Neither the name of the author nor the names of any contributors may be
+//    used to endorse or promote products derived from this software without
+//    specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include "arr/syscall_exception.hpp"
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace arr {
+
+/// \addtogroup directory_traversal
+/// @{
+
+///
+/// Failure recorded by a directory_error_log
+///
+struct directory_error {
+  int error;                    ///< Value of errno
+  const char * operation;       ///< Name of the function that failed
+  std::size_t path_offset;      ///< Offset of the path in the log
+  std::size_t path_size;        ///< Length of the path
+};
+
+///
+/// Compact record of failures during directory traversal
+///
+/// By default, a traversal reports each failure as a cloned
+/// \c syscall_exception in a list.  When a log is given in the
+/// \c directory_options, the failing calls are instead made without
+/// throwing, and each failure is recorded as an error number, the name of the
+/// function, and a path appended to a single buffer.  An exception is only
+/// built if requested with \c exception.
+///
+/// Alternatively, a handler may be given, which is called for each failure
+/// instead of recording it.
+///
+/// Recording is serialized by a mutex, so that one log may be shared by the
+/// workers of a parallel traversal, and calls to the handler are serialized
+/// as well.  The accessors must not be used concurrently with recording.
+///
+struct directory_error_log {
+  using handler_type = std::function<
+    void(int error, const char * operation, std::string_view path)>;
+
+  directory_error_log() = default;
+
+  /// Construct a log that calls \c handler instead of recording failures
+  explicit directory_error_log(handler_type handler)
+    : _handler(std::move(handler))
+  { }
+
+  directory_error_log(const directory_error_log& ) = delete;
+  directory_error_log& operator=(const directory_error_log& ) = delete;
+
+  ///
+  /// Record a failure
+  ///
+  /// @param error       Value of errno
+  /// @param operation   Name of the function that failed, which must have
+  ///                    static storage duration
+  /// @param append_path Called as \c append_path(buffer) to append the path
+  ///                    to a \c std::string
+  ///
+  template <typename F>
+  void record(int error, const char * operation, F&& append_path);
+
+  bool empty() const noexcept { return _errors.empty(); }
+  std::size_t size() const noexcept { return _errors.size(); }
+  auto begin() const noexcept { return _errors.begin(); }
+  auto end()   const noexcept { return _errors.end(); }
+
+  /// Path of a recorded failure
+  std::string_view path(const directory_error& e) const noexcept {
+    return std::string_view(_paths).substr(e.path_offset, e.path_size);
+  }
+
+  /// Build the exception describing a recorded failure
+  std::unique_ptr<syscall_exception> exception(
+      const directory_error& e) const;
+
+  /// Discard all recorded failures
+  void clear() noexcept;
+
+private:
+  std::mutex _lock;
+  std::vector<directory_error> _errors;
+  std::string _paths;           ///< Paths of all failures, concatenated
+  handler_type _handler;
+};
+
+template <typename F>
+void directory_error_log::record(
+    int error, const char * operation, F&& append_path) {
+  std::lock_guard<std::mutex> guard(_lock);
+  directory_error e{error, operation, _paths.size(), 0u};
+  append_path(_paths);
+  e.path_size = _paths.size() - e.path_offset;
+  if (_handler) {
+    try {
+      _handler(error, operation, path(e));
+    } catch (...) {
+      _paths.resize(e.path_offset);
+      throw;
+    }
+    _paths.resize(e.path_offset);
+  } else {
+    _errors.push_back(e);
+  }
+}
+
+/// @}
+
+}
+
+#endif
@@ -0,0 +1,192 @@
+//
+// Copyright (c) 2026
+// Kyle Markley.  All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+// 3. Neither the name of the author nor the names of any contributors may be
+//    used to endorse or promote products derived from this software without
+//    specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include "arrtest/arrtest.hpp"
+#include "arr/directory_error_log.hpp"
+#include "arr/fcntl.hpp"
+#include "arr/parallel_directory_traversal.hpp"
+#include "arr/path_exception.hpp"
+#include "arr/recursive_directory_sequence.hpp"
+#include "arr/temp_dir.hpp"
+#include "arr/unistd.hpp"
+#include <cerrno>
+#include <iostream>
+#include <string>
+
+UNIT_TEST_MAIN
+
+using namespace arr;
+using namespace std;
+
+namespace {
+
+directory_options logging(directory_error_log& log,
+    directory_reader reader = directory_reader::readdir) {
+  directory_options options;
+  options.reader = reader;
+  options.errors = &log;
+  return options;
+}
+
+}
+
+SUITE(recording) {
+
+  TEST(record) {
+    directory_error_log log;
+    log.record(ENOENT, "openat", [](string& b) { b += "/a/b/"; });
+    log.record(EACCES, "fstatat", [](string& b) { b += "/a/c"; });
+    CHECK_EQUAL(2u, log.size());
+    auto i = log.begin();
+    CHECK_EQUAL(ENOENT, i->error);
+    CHECK_EQUAL(string("openat"), i->operation);
+    CHECK_EQUAL("/a/b/", log.path(*i));
+    ++i;
+    CHECK_EQUAL("/a/c", log.path(*i));
+    auto e = log.exception(*i);
+    CHECK_EQUAL(true, e->code() == std::errc::permission_denied);
+    auto p = dynamic_cast<path_exception *>(e.get());
+    CHECK_EQUAL(true, nullptr != p);
+    if (p) CHECK_EQUAL("/a/c", p->path());
+    cout << e->what() << endl;
+    log.clear();
+    CHECK_EQUAL(true, log.empty());
+  }
+
+  TEST(handler) {
+    string seen;
+    directory_error_log log([&](int error, const char * op, string_view path) {
+      seen += to_string(error) + ' ' + op + ' ' + string(path) + ';';
+    });
+    log.record(ENOENT, "openat", [](string& b) { b += "x/"; });
+    log.record(ENOTDIR, "openat", [](string& b) { b += "y/"; });
+    CHECK_EQUAL(true, log.empty());
+    CHECK_EQUAL(to_string(ENOENT) + " openat x/;" +
+        to_string(ENOTDIR) + " openat y/;", seen);
+  }
+
+}
+
+SUITE(traversal) {
+
+  TEST(missing_root) {
+    temp_dir dir;
+    auto root = string(dir.name()) + "/missing";
+    for (auto reader : { directory_reader::readdir, directory_reader::bulk }) {
+      directory_error_log log;
+      directory_sequence ds(root, logging(log, reader));
+      CHECK_EQUAL(true, ds.begin() == ds.end());
+      CHECK_EQUAL(true, ds.exceptions.empty());
+      CHECK_EQUAL(1u, log.size());
+      if (log.empty()) continue;
+      CHECK_EQUAL(ENOENT, log.begin()->error);
+      CHECK_EQUAL(string("openat"), log.begin()->operation);
+      CHECK_EQUAL(root + '/', log.path(*log.begin()));
+    }
+  }
+
+  TEST(subdirectory) {
+    // A subdirectory replaced by a file after it was read from its parent
+    temp_dir dir;
+    auto root = string(dir.name());
+    wrap::mkdir(SOURCE_CONTEXT, (root + "/d").c_str(), 0700);
+    directory_error_log log;
+    recursive_directory_sequence rds(root,
+        recursive_directory_sequence::dir_order::pre,
+        recursive_directory_sequence::visit_type::all, logging(log));
+    unsigned n = 0;
+    for (auto i = rds.begin(); i != rds.end(); ++i) {
+      ++n;
+      wrap::rmdir(SOURCE_CONTEXT, (root + "/d").c_str());
+      wrap::open(SOURCE_CONTEXT, (root + "/d").c_str(),
+          O_WRONLY|O_CREAT, 0600);
+    }
+    CHECK_EQUAL(1u, n);
+    CHECK_EQUAL(true, rds.exceptions.empty());
+    CHECK_EQUAL(1u, log.size());
+    if (log.empty()) return;
+    CHECK_EQUAL(ENOTDIR, log.begin()->error);
+    CHECK_EQUAL(root + "/d/", log.path(*log.begin()));
+  }
+
+  TEST(subdirectory_exception) {
+    // As above, without a log
+    temp_dir dir;
+    auto root = string(dir.name());
+    wrap::mkdir(SOURCE_CONTEXT, (root + "/d").c_str(), 0700);
+    recursive_directory_sequence rds(root);
+    for (auto i = rds.begin(); i != rds.end(); ++i) {
+      wrap::rmdir(SOURCE_CONTEXT, (root + "/d").c_str());
+      wrap::open(SOURCE_CONTEXT, (root + "/d").c_str(),
+          O_WRONLY|O_CREAT, 0600);
+    }
+    CHECK_EQUAL(1u, rds.exceptions.size());
+    if (rds.exceptions.empty()) return;
+    try {
+      rds.exceptions.front()->raise();
+      CHECK_CATCH(path_exception, e);
+      CHECK_EQUAL(true, e.code() == errc::not_a_directory);
+      CHECK_EQUAL(root + "/d/", e.path());
+    }
+  }
+
+  TEST(follow) {
+    // A link to itself fails with ELOOP, but a dangling link is no failure
+    temp_dir dir;
+    auto root = string(dir.name());
+    CHECK_EQUAL(0, ::symlink("loop", (root + "/loop").c_str()));
+    CHECK_EQUAL(0, ::symlink("missing", (root + "/dangling").c_str()));
+    traversal_options rules;
+    rules.follow_symlinks = true;
+    directory_error_log log;
+    recursive_directory_sequence rds(root,
+        recursive_directory_sequence::dir_order::pre,
+        recursive_directory_sequence::visit_type::all, logging(log), rules);
+    unsigned n = 0;
+    for (auto i = rds.begin(); i != rds.end(); ++i) ++n;
+    CHECK_EQUAL(2u, n);
+    CHECK_EQUAL(1u, log.size());
+    if (log.empty()) return;
+    CHECK_EQUAL(ELOOP, log.begin()->error);
+    CHECK_EQUAL(string("fstatat"), log.begin()->operation);
+    CHECK_EQUAL(root + "/loop", log.path(*log.begin()));
+  }
+
+  TEST(parallel) {
+    temp_dir dir;
+    auto root = string(dir.name()) + "/missing";
+    directory_error_log log;
+    parallel_directory_traversal pdt(root, 2u,
+        parallel_directory_traversal::visit_type::all, logging(log));
+    pdt.run([](const parallel_directory_entry&) { });
+    CHECK_EQUAL(true, pdt.exceptions.empty());
+    CHECK_EQUAL(1u, log.size());
+  }
+
+}
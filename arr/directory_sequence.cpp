@@ -1,5 +1,5 @@
 //
-// Copyright (c) 2012, 2014, 2021
+// Copyright (c) 2012, 2014, 2021, 2026
 // Kyle Markley.  All rights reserved.
 //
 // Redistribution and use in source and binary forms, with or without
@@ -29,31 +29,101 @@
 
 #include "arr/directory_sequence.hpp"
 #include "arr/dirent.hpp"
+#include "arr/fcntl.hpp"
+#include "arr/file_descriptor.hpp"
+#include "arr/path_exception.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
 #include <utility>
+#include <vector>
+#include <unistd.h>
+#if defined(__linux__)
+#include <sys/syscall.h>
+#endif
 
 namespace {
-  const std::string current_dir(".");
-  const std::string parent_dir("..");
   constexpr char separator = '/';
+
+  /// Whether an entry is "." or ".."
+  bool is_dot_or_dot_dot(const char * name) noexcept {
+    return '.' == name[0] and
+      ('\0' == name[1] or ('.' == name[1] and '\0' == name[2]));
+  }
+
+#if defined(__linux__)
+  ///
+  /// Whether records from getdents64 may be used as a struct dirent
+  ///
+  /// This holds for glibc and musl with a 64-bit ino_t and off_t.  The
+  /// record for the last entry in a batch may be shorter than a struct
+  /// dirent, so the buffer is padded by the size of one.
+  ///
+  constexpr bool bulk_layout =
+    8u == sizeof(dirent::d_ino) and
+    8u == sizeof(dirent::d_off) and
+    16u == offsetof(struct dirent, d_reclen) and
+    18u == offsetof(struct dirent, d_type) and
+    19u == offsetof(struct dirent, d_name);
+#endif
 }
 
 namespace arr {
 
 directory_iterator::directory_iterator(directory_sequence * ds)
-  : dir( ds ? wrap::opendir(SOURCE_CONTEXT, ds->path().c_str()) : nullptr )
-  , container(ds)
+  : container(ds)
 {
+  if (ds) open();
   ++*this;
 }
 
+void directory_iterator::open() {
+  constexpr int flags = O_RDONLY|O_DIRECTORY|O_CLOEXEC;
+  if (not container->options().errors) {
+    try {
+      wrap::file_descriptor fd = wrap::openat(SOURCE_CONTEXT,
+          container->_parent_fd, container->_name.c_str(), flags, 0);
+      dir = wrap::fdopendir(SOURCE_CONTEXT, fd.get());
+      descriptor = fd.release();
+    } catch (syscall_exception& e) {
+      // Name the whole path, rather than that relative to the parent
+      std::string path;
+      container->append_path(path);
+      throw path_exception(e, e.function(), std::move(path),
+          e.code().value());
+    }
+    return;
+  }
+  auto fd = ::openat(container->_parent_fd, container->_name.c_str(), flags);
+  if (-1 == fd) return fail(errno, "openat");
+  auto d = ::fdopendir(fd);
+  if (not d) {
+    auto error = errno;
+    ::close(fd);
+    return fail(error, "fdopendir");
+  }
+  dir = d;
+  descriptor = fd;
+}
+
+void directory_iterator::fail(
+    int error, const char * operation, const char * name) {
+  container->options().errors->record(error, operation,
+      [&](std::string& path) {
+        container->append_path(path);
+        if (name) path += name;
+      });
+}
+
 directory_iterator& directory_iterator::operator++() {
-  if (dir.valid()) {
+  if (dir.valid() or is_detached) {
     try {
       do {
-        entry = wrap::readdir(SOURCE_CONTEXT, dir.get());
-      } while (entry and DT_DIR == entry->d_type and
-          (current_dir == entry->d_name or
-            parent_dir == entry->d_name));
+        entry = next_entry();
+      } while (entry and is_dot_or_dot_dot(entry->d_name));
+      type_resolved = false;
+      link_resolved = false;
     } catch (syscall_exception& e) {
       entry = nullptr;
       container->exceptions.emplace_back(e.clone());
@@ -62,12 +132,210 @@ directory_iterator& directory_iterator::operator++() {
   return *this;
 }
 
-directory_sequence::directory_sequence(std::string dir)
-  : _path(std::move(dir))
+unsigned char directory_iterator::type() {
+  if (DT_UNKNOWN == entry->d_type and not type_resolved) {
+    type_resolved = true;
+    struct stat sb;
+    if (container->options().errors) {
+      if (0 == ::fstatat(descriptor, entry->d_name, &sb, AT_SYMLINK_NOFOLLOW)) {
+        entry->d_type = static_cast<unsigned char>(IFTODT(sb.st_mode));
+      } else {
+        fail(errno, "fstatat", entry->d_name);
+      }
+      return entry->d_type;
+    }
+    try {
+      wrap::fstatat(SOURCE_CONTEXT,
+          descriptor, entry->d_name, &sb, AT_SYMLINK_NOFOLLOW);
+      entry->d_type = static_cast<unsigned char>(IFTODT(sb.st_mode));
+    } catch (syscall_exception& e) {
+      container->exceptions.emplace_back(e.clone());
+    }
+  }
+  return entry->d_type;
+}
+
+unsigned char directory_iterator::follow() {
+  if (DT_LNK == type() and not link_resolved) {
+    link_resolved = true;
+    struct stat sb;
+    // A dangling link is not a failure
+    auto dangling = [](int error) {
+      return ENOENT == error or ENOTDIR == error;
+    };
+    if (container->options().errors) {
+      if (0 == ::fstatat(descriptor, entry->d_name, &sb, 0)) {
+        entry->d_type = static_cast<unsigned char>(IFTODT(sb.st_mode));
+      } else if (not dangling(errno)) {
+        fail(errno, "fstatat", entry->d_name);
+      }
+      return entry->d_type;
+    }
+    try {
+      wrap::fstatat(SOURCE_CONTEXT, descriptor, entry->d_name, &sb, 0);
+      entry->d_type = static_cast<unsigned char>(IFTODT(sb.st_mode));
+    } catch (syscall_exception& e) {
+      if (not dangling(e.code().value())) {
+        container->exceptions.emplace_back(e.clone());
+      }
+    }
+  }
+  return entry->d_type;
+}
+
+void directory_iterator::detach() {
+  if (is_detached or not dir.valid()) return;
+  constexpr auto header = offsetof(struct dirent, d_name);
+  std::vector<char> records;
+  auto keep = [&](const struct dirent * e) {
+    auto length = std::strlen(e->d_name) + 1u;
+    auto size = (header + length + 7u) / 8u * 8u;
+    auto offset = records.size();
+    records.resize(offset + size);
+    auto record = records.data() + offset;
+    std::memcpy(record, e, header);
+    std::memcpy(record + header, e->d_name, length);
+    auto reclen = static_cast<decltype(e->d_reclen)>(size);
+    std::memcpy(record + offsetof(struct dirent, d_reclen),
+        &reclen, sizeof(reclen));
+  };
+  if (entry) keep(entry);
+  try {
+    while (auto e = next_entry()) {
+      if (not is_dot_or_dot_dot(e->d_name)) keep(e);
+    }
+  } catch (syscall_exception& e) {
+    container->exceptions.emplace_back(e.clone());
+  }
+  // Padded by one struct dirent, as for the bulk reader
+  buffer.reset(new char[records.size() + sizeof(struct dirent)]);
+  std::copy(records.begin(), records.end(), buffer.get());
+  buffer_used = records.size();
+  buffer_offset = 0u;
+  is_detached = true;
+  if (entry) entry = next_entry();
+  dir = wrap::directory();
+  descriptor = -1;
+}
+
+void directory_iterator::reopen(const char * path) {
+  constexpr int flags = O_RDONLY|O_DIRECTORY|O_CLOEXEC;
+  if (not is_detached or -1 != descriptor) return;
+  if (container->options().errors) {
+    auto fd = ::openat(AT_FDCWD, path, flags);
+    if (-1 == fd) return fail(errno, "openat");
+    reopened = fd;
+  } else {
+    try {
+      reopened = wrap::openat(SOURCE_CONTEXT, AT_FDCWD, path, flags, 0);
+    } catch (syscall_exception& e) {
+      container->exceptions.emplace_back(e.clone());
+      return;
+    }
+  }
+  descriptor = reopened.get();
+}
+
+struct dirent * directory_iterator::next_entry() {
+  if (is_detached) {
+    if (buffer_offset >= buffer_used) return nullptr;
+    auto record = static_cast<struct dirent *>(
+        static_cast<void *>(buffer.get() + buffer_offset));
+    buffer_offset += record->d_reclen;
+    return record;
+  }
+#if defined(__linux__)
+  if (bulk_layout and
+      directory_reader::bulk == container->options().reader) {
+    return next_bulk_entry();
+  }
+#endif
+  if (container->options().errors) {
+    errno = 0;
+    auto r = ::readdir(dir.get());
+    if (not r and errno) fail(errno, "readdir");
+    return r;
+  }
+  return wrap::readdir(SOURCE_CONTEXT, dir.get());
+}
+
+struct dirent * directory_iterator::next_bulk_entry() {
+#if defined(__linux__)
+  if (buffer_offset >= buffer_used) {
+    auto size = std::max(container->options().buffer_size,
+        sizeof(struct dirent));
+    if (not buffer) buffer.reset(new char[size + sizeof(struct dirent)]);
+    buffer_offset = 0u;
+    buffer_used = 0u;
+    if (container->options().errors) {
+      auto r = ::syscall(SYS_getdents64, descriptor, buffer.get(), size);
+      if (-1 == r) fail(errno, "getdents64");
+      else buffer_used = static_cast<std::size_t>(r);
+    } else {
+      buffer_used = wrap::getdents64(SOURCE_CONTEXT,
+          descriptor, buffer.get(), size);
+    }
+    if (0u == buffer_used) return nullptr;
+  }
+  auto record = static_cast<struct dirent *>(
+      static_cast<void *>(buffer.get() + buffer_offset));
+  buffer_offset += record->d_reclen;
+  return record;
+#else
+  return nullptr;
+#endif
+}
+
+directory_sequence::directory_sequence(std::string dir,
+    directory_options options)
+  : _parent_fd(AT_FDCWD)
+  , _path(std::move(dir))
+  , _options(options)
 {
   if (_path.empty() or separator != _path.back()) {
     _path += separator;
   }
+  _name = _path;
+}
+
+directory_sequence::directory_sequence(
+    const directory_sequence& parent,
+    const directory_iterator& entry)
+  : _parent(&parent)
+  , _parent_fd(entry.dir_fd())
+  , _name(entry->d_name)
+  , _options(parent.options())
+{
+}
+
+directory_sequence::directory_sequence(
+    int dir_fd,
+    std::string name,
+    std::string path,
+    directory_options options)
+  : _parent_fd(dir_fd)
+  , _name(std::move(name))
+  , _path(std::move(path))
+  , _options(options)
+{
+  if (_path.empty() or separator != _path.back()) {
+    _path += separator;
+  }
+}
+
+const std::string& directory_sequence::path() const {
+  if (_path.empty()) _path = _parent->path() + _name + separator;
+  return _path;
+}
+
+void directory_sequence::append_path(std::string& buffer) const {
+  if (_path.empty()) {
+    _parent->append_path(buffer);
+    buffer += _name;
+    buffer += separator;
+  } else {
+    buffer += _path;
+  }
 }
 
 directory_iterator directory_sequence::begin() {
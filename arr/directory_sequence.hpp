@@ -1,7 +1,7 @@
 #ifndef ARR_DIRECTORY_SEQUENCE_HPP
 #define ARR_DIRECTORY_SEQUENCE_HPP
 //
-// Copyright (c) 2012, 2021
+// Copyright (c) 2012, 2021, 2026
 // Kyle Markley.  All rights reserved.
 //
 // Redistribution and use in source and binary forms, with or without
@@ -30,7 +30,10 @@
 //
 
 #include "arr/directory.hpp"
+#include "arr/directory_error_log.hpp"
+#include "arr/file_descriptor.hpp"
 #include "arr/syscall_exception.hpp"
+#include <cstddef>
 #include <iterator>
 #include <string>
 #include <list>
@@ -43,9 +46,32 @@ struct directory_sequence;
 /// \addtogroup directory_traversal
 /// @{
 
+///
+/// Method of reading directory entries
+///
+enum class directory_reader {
+  readdir,      ///< One call to readdir(3) per entry
+  bulk,         ///< Batches of entries from getdents64(2), on Linux
+};
+
+///
+/// Options for reading a directory
+///
+struct directory_options {
+  directory_reader reader = directory_reader::readdir;
+  std::size_t buffer_size = 64u * 1024u;  ///< Bytes read per bulk batch
+  directory_error_log * errors = nullptr; ///< If set, where failures are
+                                          ///< recorded instead of exceptions
+};
+
 ///
 /// Iterator for the sequence of files in a directory
 ///
+/// With \c directory_reader::bulk, entries refer to packed records in a
+/// buffer owned by the iterator, which is refilled with one system call for
+/// as many entries as fit.  Where the bulk reader is unavailable, entries are
+/// read with readdir(3).
+///
 struct directory_iterator {
   using iterator_category = std::input_iterator_tag;
   using value_type        = const struct dirent;
@@ -65,29 +91,128 @@ struct directory_iterator {
     return !(a==b);
   }
   directory_iterator& operator++();
-  reference operator* () noexcept { return *entry; }
-  pointer   operator->() noexcept { return  entry; }
+  reference operator* () const noexcept { return *entry; }
+  pointer   operator->() const noexcept { return  entry; }
+
+  /// Descriptor of the directory being read, for use with the *at functions
+  int dir_fd() const noexcept { return descriptor; }
+
+  ///
+  /// Read the remaining entries into memory and close the directory
+  ///
+  /// The current entry stays valid, and the iterator continues through the
+  /// remaining entries from a buffer packed as for the bulk reader.  The
+  /// descriptor is closed, so \c dir_fd is -1 until \c reopen.
+  ///
+  void detach();
+
+  ///
+  /// Open the directory again, after \c detach, so that \c dir_fd is valid
+  ///
+  /// @param path Path of the directory
+  ///
+  /// A failure is recorded by the sequence.
+  ///
+  void reopen(const char * path);
+
+  /// Whether \c detach has been called
+  bool detached() const noexcept { return is_detached; }
+
+  ///
+  /// Type of the current entry, as for \c d_type
+  ///
+  /// Some filesystems report \c DT_UNKNOWN for every entry.  The type is
+  /// then resolved with fstatat(2), without following a symbolic link, and
+  /// stored into the entry, so that later reads of \c d_type see it.  If
+  /// that fails, the exception is recorded by the sequence and the type
+  /// remains \c DT_UNKNOWN.
+  ///
+  unsigned char type();
+
+  ///
+  /// Type of the current entry, resolving a symbolic link to its target
+  ///
+  /// As for \c type, but the type of the target of a symbolic link is
+  /// stored into the entry.  A dangling link remains \c DT_LNK, and is not
+  /// reported; other failures are recorded by the sequence.
+  ///
+  unsigned char follow();
 private:
   wrap::directory dir;
   directory_sequence * container = nullptr;
-  pointer entry = nullptr;
+  struct dirent * entry = nullptr;
+  int descriptor = -1;
+  bool type_resolved = false;           ///< Whether \c type was attempted
+  bool link_resolved = false;           ///< Whether \c follow was attempted
+  bool is_detached = false;             ///< Whether entries are in memory
+  wrap::file_descriptor reopened;       ///< Descriptor after \c reopen
+  std::unique_ptr<char[]> buffer;       ///< Records for the bulk reader
+  std::size_t buffer_used = 0u;         ///< Bytes of records in the buffer
+  std::size_t buffer_offset = 0u;       ///< Offset of the next record
+  struct dirent * next_entry();
+  struct dirent * next_bulk_entry();
+  void open();
+  void fail(int error, const char * operation, const char * name = nullptr);
 };
 
 ///
 /// Filesystem directory sequence with an iterator interface
 ///
+/// A subdirectory may be opened relative to the descriptor of its parent,
+/// so that the kernel does not resolve the whole path again.  Its path is
+/// then only built if requested.
+///
 struct directory_sequence {
-  directory_sequence(std::string directory);
+  directory_sequence(std::string directory, directory_options options = {});
+
+  ///
+  /// Construct the sequence of a subdirectory, relative to its parent
+  ///
+  /// @param parent Sequence containing the subdirectory
+  /// @param entry  Iterator of \c parent referring to the subdirectory
+  ///
+  /// \c entry must remain valid until \c begin is called, and \c parent
+  /// must remain valid while \c path may be called.
+  ///
+  directory_sequence(
+      const directory_sequence& parent,
+      const directory_iterator& entry);
+
+  ///
+  /// Construct the sequence of a directory, relative to a descriptor
+  ///
+  /// @param dir_fd  Descriptor of the directory containing \c name
+  /// @param name    Name of the directory, relative to \c dir_fd
+  /// @param path    Path of the directory, as reported by \c path
+  /// @param options Options for reading the directory
+  ///
+  /// \c dir_fd must remain open until \c begin is called.
+  ///
+  directory_sequence(
+      int dir_fd,
+      std::string name,
+      std::string path,
+      directory_options options = {});
+
   directory_iterator begin();
   directory_iterator end()  const noexcept { return directory_iterator(); }
-  const std::string& path() const noexcept { return _path; }
+  const std::string& path() const;
+  const directory_options& options() const noexcept { return _options; }
 
   ///
   /// Exceptions encountered during directory traversal
   ///
+  /// These are not used if the options give a \c directory_error_log.
+  ///
   std::list<std::unique_ptr<syscall_exception>> exceptions;
 private:
-  std::string _path;
+  friend directory_iterator;
+  void append_path(std::string& buffer) const;
+  const directory_sequence * _parent = nullptr;
+  int _parent_fd;               ///< Descriptor to which \c _name is relative
+  std::string _name;            ///< Name used to open the directory
+  mutable std::string _path;    ///< Path, with a trailing separator
+  directory_options _options;
 };
 
 /// @}
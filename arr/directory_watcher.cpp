@@ -0,0 +1,546 @@
+//
+// Copyright (c) 2026
+// Kyle Markley.  All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+// 3. Neither the name of the author nor the names of any contributors may be
+//    used to endorse or promote products derived from this software without
+//    specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include "arr/directory_watcher.hpp"
+
+#if defined(__linux__)
+
+#include "arr/fcntl.hpp"
+#include "arr/file_descriptor.hpp"
+#include "arr/inotify.hpp"
+#include "arr/pipe.hpp"
+#include "arr/poll.hpp"
+#include "arr/recursive_directory_sequence.hpp"
+#include "arr/unistd.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <list>
+#include <map>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace arr {
+
+namespace {
+
+constexpr std::uint32_t watch_mask = IN_CREATE|IN_DELETE|IN_MODIFY|
+  IN_MOVED_FROM|IN_MOVED_TO|IN_DELETE_SELF|IN_MOVE_SELF|
+  IN_ONLYDIR|IN_DONT_FOLLOW|IN_EXCL_UNLINK;
+
+/// Whether a path is \c base or below it
+bool within(const std::string& path, const std::string& base) {
+  if (base.empty()) return true;
+  return 0 == path.compare(0, base.size(), base) and
+    (path.size() == base.size() or '/' == path[base.size()]);
+}
+
+std::string join(const std::string& dir, std::string_view name) {
+  if (dir.empty()) return std::string(name);
+  std::string path = dir;
+  path += '/';
+  path += name;
+  return path;
+}
+
+/// State of an entry in a polled subtree
+struct stamp {
+  std::int64_t mtime;
+  std::int64_t size;
+  unsigned char type;
+  bool operator==(const stamp&) const = default;
+};
+
+/// Subtree that is polled rather than watched
+struct polled_tree {
+  std::string path;
+  std::map<std::string, stamp> entries;
+};
+
+}
+
+std::ostream& operator<<(std::ostream& o, watch_change change) {
+  switch (change) {
+    case watch_change::created:    return o << "created";
+    case watch_change::deleted:    return o << "deleted";
+    case watch_change::modified:   return o << "modified";
+    case watch_change::moved_from: return o << "moved_from";
+    case watch_change::moved_to:   return o << "moved_to";
+    case watch_change::rescan:     return o << "rescan";
+  }
+  return o;
+}
+
+struct directory_watcher::implementation {
+  using clock = std::chrono::steady_clock;
+
+  implementation(std::string r, queue_type& q, watcher_options o);
+  std::string full(const std::string& path) const {
+    if (path.empty()) return root;
+    return '/' == root.back() ? root + path : root + '/' + path;
+  }
+  /// Length of the prefix of a traversal's paths below \c path
+  std::size_t prefix(const std::string& path) const {
+    auto directory = full(path);
+    return directory.size() + ('/' == directory.back() ? 0u : 1u);
+  }
+  bool watch(const std::string& path);
+  void watch_tree(const std::string& path, bool report);
+  void unwatch_tree(const std::string& path);
+  void rename_tree(const std::string& from, const std::string& to);
+  void forget_trees(const std::string& path);
+  void add(watch_change change, std::string path, bool directory);
+  void read_events();
+  void flush();
+  std::map<std::string, stamp> snapshot(const std::string& path);
+  void poll_tree(const std::string& path);
+  void rescan();
+  void run();
+
+  std::string root;
+  queue_type& queue;
+  watcher_options options;
+  wrap::file_descriptor inotify;
+  arr::pipe wake;
+  std::unordered_map<int, std::string> paths;   ///< Watched directories
+  std::map<std::string, int> descriptors;       ///< Inverse of paths
+  std::list<polled_tree> trees;
+  std::unordered_map<std::uint32_t, std::string> moved_directories;
+                                                ///< Awaiting moved_to
+  struct pending_event {
+    watch_event event;
+    bool dropped;
+  };
+  std::vector<pending_event> pending;
+  std::unordered_map<std::string, std::size_t> mergeable;
+                                                ///< Last event of a path
+  std::size_t buffer_size;      ///< Bytes of buffer, enough for any event
+  std::unique_ptr<char[]> buffer;
+  std::atomic<std::size_t> watch_count {0u};
+  std::atomic<std::size_t> tree_count {0u};
+  std::atomic<bool> stopping {false};
+  bool root_gone = false;                       ///< Root deleted or moved
+  std::exception_ptr error;
+  std::thread thread;
+};
+
+directory_watcher::implementation::implementation(
+    std::string r, queue_type& q, watcher_options o)
+  : root(std::move(r))
+  , queue(q)
+  , options(o)
+  , inotify(wrap::inotify_init1(SOURCE_CONTEXT, IN_NONBLOCK|IN_CLOEXEC))
+  , wake(SOURCE_CONTEXT)
+  , buffer_size(std::max(options.buffer_size,
+        sizeof(struct inotify_event) + NAME_MAX + 1u))
+  , buffer(new char[buffer_size])
+{
+  while (root.size() > 1u and '/' == root.back()) root.pop_back();
+}
+
+bool directory_watcher::implementation::watch(const std::string& path) {
+  if (paths.size() >= options.max_watches) {
+    poll_tree(path);
+    return false;
+  }
+  try {
+    auto wd = wrap::inotify_add_watch(SOURCE_CONTEXT,
+        inotify.get(), full(path).c_str(), watch_mask);
+    paths[wd] = path;
+    descriptors[path] = wd;
+    watch_count.store(paths.size(), std::memory_order::relaxed);
+    return true;
+  } catch (syscall_exception& e) {
+    auto code = e.code().value();
+    if (ENOSPC == code or ENOMEM == code) poll_tree(path);
+    // Otherwise, the directory was removed or cannot be read
+    return false;
+  }
+}
+
+void directory_watcher::implementation::watch_tree(
+    const std::string& path, bool report) {
+  if (not watch(path)) return;
+  using rds_type = recursive_directory_sequence;
+  rds_type rds(full(path), rds_type::dir_order::pre,
+      report ? rds_type::visit_type::all : rds_type::visit_type::directory);
+  auto skip = prefix(path);
+  for (auto i = rds.begin(); i != rds.end(); ++i) {
+    auto sub = join(path, rds.full_path().substr(skip));
+    bool directory = DT_DIR == i->d_type;
+    if (report) add(watch_change::created, sub, directory);
+    if (directory and not watch(sub)) rds.abandon();
+  }
+}
+
+void directory_watcher::implementation::unwatch_tree(const std::string& path) {
+  auto i = descriptors.lower_bound(path);
+  while (i != descriptors.end() and 0 == i->first.compare(0, path.size(), path)
+      and (i->first.size() == path.size() or '/' == i->first[path.size()])) {
+    try {
+      wrap::inotify_rm_watch(SOURCE_CONTEXT, inotify.get(), i->second);
+    } catch (syscall_exception&) {
+      // Already removed by the kernel
+    }
+    paths.erase(i->second);
+    i = descriptors.erase(i);
+  }
+  watch_count.store(paths.size(), std::memory_order::relaxed);
+}
+
+void directory_watcher::implementation::rename_tree(
+    const std::string& from, const std::string& to) {
+  std::vector<std::pair<std::string, int>> moved;
+  auto i = descriptors.lower_bound(from);
+  while (i != descriptors.end() and 0 == i->first.compare(0, from.size(), from)
+      and (i->first.size() == from.size() or '/' == i->first[from.size()])) {
+    moved.emplace_back(to + i->first.substr(from.size()), i->second);
+    i = descriptors.erase(i);
+  }
+  for (auto& [path, wd] : moved) {
+    paths[wd] = path;
+    descriptors[path] = wd;
+  }
+  for (auto& tree : trees) {
+    if (not within(tree.path, from)) continue;
+    tree.path = to + tree.path.substr(from.size());
+    std::map<std::string, stamp> entries;
+    for (auto& [path, s] : tree.entries) {
+      entries.emplace(to + path.substr(from.size()), s);
+    }
+    tree.entries = std::move(entries);
+  }
+}
+
+void directory_watcher::implementation::forget_trees(const std::string& path) {
+  trees.remove_if([&](const polled_tree& tree) {
+    return within(tree.path, path);
+  });
+  tree_count.store(trees.size(), std::memory_order::relaxed);
+}
+
+void directory_watcher::implementation::add(
+    watch_change change, std::string path, bool directory) {
+  auto i = mergeable.find(path);
+  if (i != mergeable.end()) {
+    auto& e = pending[i->second];
+    auto previous = e.event.change;
+    if (previous == change and watch_change::modified == change) return;
+    if (previous == change and watch_change::created == change) return;
+    if (watch_change::created == previous and
+        watch_change::modified == change) {
+      return;
+    }
+    if (watch_change::deleted == change) {
+      if (watch_change::created == previous) {
+        e.dropped = true;
+        mergeable.erase(i);
+        return;
+      }
+      if (watch_change::modified == previous) {
+        e.dropped = true;
+      }
+    }
+  }
+  if (watch_change::created == change or watch_change::modified == change) {
+    mergeable[path] = pending.size();
+  } else {
+    mergeable.erase(path);
+  }
+  pending.push_back({{change, directory, std::move(path)}, false});
+}
+
+void directory_watcher::implementation::read_events() {
+  for (;;) {
+    std::size_t size;
+    try {
+      size = wrap::read(SOURCE_CONTEXT, inotify.get(),
+          buffer.get(), buffer_size);
+    } catch (syscall_exception& e) {
+      if (EAGAIN == e.code().value()) return;
+      throw;
+    }
+    for (std::size_t offset = 0; offset < size; ) {
+      struct inotify_event event;
+      std::memcpy(&event, buffer.get() + offset, sizeof(event));
+      std::string_view name;
+      if (event.len) name = buffer.get() + offset + sizeof(event);
+      offset += sizeof(event) + event.len;
+
+      if (event.mask & IN_Q_OVERFLOW) {
+        add(watch_change::rescan, "", true);
+        continue;
+      }
+      auto p = paths.find(event.wd);
+      if (p == paths.end()) continue;
+      if (event.mask & (IN_DELETE_SELF|IN_MOVE_SELF)) {
+        // Only the root's own removal is reported; that of a subdirectory
+        // is reported through its parent
+        if (p->second.empty()) {
+          add(event.mask & IN_DELETE_SELF ? watch_change::deleted
+              : watch_change::moved_from, "", true);
+          root_gone = true;
+        }
+        continue;
+      }
+      if (event.mask & IN_IGNORED) {
+        auto d = descriptors.find(p->second);
+        if (d != descriptors.end() and event.wd == d->second) {
+          descriptors.erase(d);
+        }
+        paths.erase(p);
+        watch_count.store(paths.size(), std::memory_order::relaxed);
+        continue;
+      }
+      if (name.empty()) continue;
+      auto path = join(p->second, name);
+      bool directory = event.mask & IN_ISDIR;
+      if (event.mask & IN_CREATE) {
+        add(watch_change::created, path, directory);
+        if (directory) watch_tree(path, true);
+      } else if (event.mask & IN_DELETE) {
+        add(watch_change::deleted, path, directory);
+        if (directory) forget_trees(path);
+      } else if (event.mask & IN_MODIFY) {
+        add(watch_change::modified, path, directory);
+      } else if (event.mask & IN_MOVED_FROM) {
+        add(watch_change::moved_from, path, directory);
+        if (directory) moved_directories[event.cookie] = path;
+      } else if (event.mask & IN_MOVED_TO) {
+        add(watch_change::moved_to, path, directory);
+        if (directory) {
+          auto m = moved_directories.find(event.cookie);
+          if (m != moved_directories.end()) {
+            rename_tree(m->second, path);
+            moved_directories.erase(m);
+          } else {
+            watch_tree(path, false);
+          }
+        }
+      }
+    }
+  }
+}
+
+void directory_watcher::implementation::flush() {
+  // Directories moved out of the tree are no longer watched
+  for (auto& [cookie, path] : moved_directories) {
+    unwatch_tree(path);
+    forget_trees(path);
+  }
+  moved_directories.clear();
+  for (auto& p : pending) {
+    if (p.dropped) continue;
+    while (queue.full()) {
+      // Either this sees stopping, or stop sees the fifo full
+      std::atomic_thread_fence(std::memory_order::seq_cst);
+      if (stopping.load(std::memory_order::relaxed)) return;
+      queue.wait_for_read();
+    }
+    queue.push(std::move(p.event));
+  }
+  pending.clear();
+  mergeable.clear();
+}
+
+std::map<std::string, stamp>
+directory_watcher::implementation::snapshot(const std::string& path) {
+  std::map<std::string, stamp> entries;
+  recursive_directory_sequence rds(full(path));
+  auto skip = prefix(path);
+  for (auto i = rds.begin(); i != rds.end(); ++i) {
+    try {
+      struct stat sb;
+      wrap::fstatat(SOURCE_CONTEXT,
+          rds.dir_fd(), i->d_name, &sb, AT_SYMLINK_NOFOLLOW);
+      entries[join(path, rds.full_path().substr(skip))] = {
+        std::int64_t(sb.st_mtim.tv_sec) * 1000000000 + sb.st_mtim.tv_nsec,
+        sb.st_size, static_cast<unsigned char>(IFTODT(sb.st_mode))};
+    } catch (syscall_exception&) {
+      // Removed while polling
+    }
+  }
+  return entries;
+}
+
+void directory_watcher::implementation::poll_tree(const std::string& path) {
+  trees.push_back({path, snapshot(path)});
+  tree_count.store(trees.size(), std::memory_order::relaxed);
+}
+
+void directory_watcher::implementation::rescan() {
+  for (auto t = trees.begin(); t != trees.end(); ) {
+    auto& tree = *t;
+    //
+    // A subtree whose directory is gone reports its entries deleted, and is
+    // no longer polled.
+    //
+    bool gone;
+    try {
+      struct stat sb;
+      wrap::fstatat(SOURCE_CONTEXT, AT_FDCWD, full(tree.path).c_str(), &sb,
+          AT_SYMLINK_NOFOLLOW);
+      gone = not S_ISDIR(sb.st_mode);
+    } catch (syscall_exception&) {
+      gone = true;
+    }
+    std::map<std::string, stamp> entries;
+    if (not gone) entries = snapshot(tree.path);
+    auto i = tree.entries.begin();
+    auto j = entries.begin();
+    while (i != tree.entries.end() or j != entries.end()) {
+      if (j == entries.end() or
+          (i != tree.entries.end() and i->first < j->first)) {
+        add(watch_change::deleted, i->first, DT_DIR == i->second.type);
+        ++i;
+      } else if (i == tree.entries.end() or j->first < i->first) {
+        add(watch_change::created, j->first, DT_DIR == j->second.type);
+        ++j;
+      } else {
+        if (i->second.type != j->second.type) {
+          add(watch_change::deleted, i->first, DT_DIR == i->second.type);
+          add(watch_change::created, j->first, DT_DIR == j->second.type);
+        } else if (DT_DIR != j->second.type and not (i->second == j->second)) {
+          add(watch_change::modified, j->first, false);
+        }
+        ++i;
+        ++j;
+      }
+    }
+    if (gone) {
+      t = trees.erase(t);
+      continue;
+    }
+    tree.entries = std::move(entries);
+    ++t;
+  }
+  tree_count.store(trees.size(), std::memory_order::relaxed);
+}
+
+void directory_watcher::implementation::run() {
+  auto never = clock::time_point::max();
+  auto flush_at = never;
+  auto rescan_at = clock::now() + options.rescan;
+  while (not stopping.load(std::memory_order::relaxed)) {
+    auto deadline = std::min(flush_at, trees.empty() ? never : rescan_at);
+    int timeout = -1;
+    if (never != deadline) {
+      auto remaining = std::chrono::ceil<std::chrono::milliseconds>(
+          deadline - clock::now());
+      timeout = static_cast<int>(std::max<long long>(0, remaining.count()));
+    }
+    struct pollfd fds[2] = {
+      { inotify.get(), POLLIN, 0 },
+      { wake.read.get(), POLLIN, 0 },
+    };
+    try {
+      wrap::poll(SOURCE_CONTEXT, fds, 2, timeout);
+    } catch (syscall_exception& e) {
+      if (EINTR == e.code().value()) continue;
+      throw;
+    }
+    if (fds[1].revents) break;
+    if (fds[0].revents & POLLIN) {
+      read_events();
+      if (not pending.empty() and never == flush_at) {
+        flush_at = clock::now() + options.coalesce;
+      }
+    }
+    auto now = clock::now();
+    if (not trees.empty() and now >= rescan_at) {
+      rescan();
+      rescan_at = now + options.rescan;
+      if (not pending.empty()) flush_at = now;
+    }
+    if (now >= flush_at or root_gone) {
+      flush();
+      flush_at = never;
+    }
+    if (root_gone) break;
+  }
+}
+
+directory_watcher::directory_watcher(
+    std::string directory,
+    queue_type& queue,
+    watcher_options options)
+  : _impl(new implementation(std::move(directory), queue, options))
+{
+  _impl->watch_tree("", false);
+  _impl->thread = std::thread([impl = _impl.get()] {
+    try {
+      impl->run();
+    } catch (...) {
+      impl->error = std::current_exception();
+    }
+  });
+}
+
+directory_watcher::~directory_watcher() {
+  try {
+    stop();
+  } catch (...) {
+  }
+}
+
+void directory_watcher::stop() {
+  if (not _impl->thread.joinable()) return;
+  _impl->stopping.store(true, std::memory_order::relaxed);
+  char byte = 0;
+  wrap::write(SOURCE_CONTEXT, _impl->wake.write.get(), &byte, 1u);
+  // Release the thread if it waits for room
+  std::atomic_thread_fence(std::memory_order::seq_cst);
+  if (_impl->queue.full()) _impl->queue.discard(1u);
+  _impl->thread.join();
+  if (_impl->error) {
+    std::rethrow_exception(std::exchange(_impl->error, nullptr));
+  }
+}
+
+const std::string& directory_watcher::root() const noexcept {
+  return _impl->root;
+}
+
+std::size_t directory_watcher::watches() const noexcept {
+  return _impl->watch_count.load(std::memory_order::relaxed);
+}
+
+std::size_t directory_watcher::polled() const noexcept {
+  return _impl->tree_count.load(std::memory_order::relaxed);
+}
+
+}
+
+#endif
@@ -0,0 +1,155 @@
+#ifndef ARR_DIRECTORY_WATCHER_HPP
+#define ARR_DIRECTORY_WATCHER_HPP
+//
+// Copyright (c) 2026
+// Kyle Markley.  All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+// 3. Neither the name of the author nor the names of any contributors may be
+//    used to endorse or promote products derived from this software without
+//    specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include "arr/fifo.hpp"
+#include <chrono>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <ostream>
+#include <string>
+
+namespace arr {
+
+#if defined(__linux__)
+
+/// \addtogroup directory_traversal
+/// @{
+
+///
+/// Kind of change reported by a directory_watcher
+///
+enum class watch_change {
+  created,      ///< Entry created, or found in a new directory
+  deleted,      ///< Entry removed
+  modified,     ///< File contents written
+  moved_from,   ///< Entry renamed away from this path
+  moved_to,     ///< Entry renamed to this path
+  rescan,       ///< Events were lost; the path must be scanned again
+};
+
+std::ostream& operator<<(std::ostream& o, watch_change change);
+
+///
+/// Change reported by a directory_watcher
+///
+struct watch_event {
+  watch_change change = watch_change::rescan;
+  bool directory = false;       ///< Whether the entry is a directory
+  std::string path;             ///< Path relative to the root
+};
+
+///
+/// Options for a directory_watcher
+///
+struct watcher_options {
+  std::chrono::milliseconds coalesce {10};
+                                ///< Delay to gather a burst of events
+  std::chrono::milliseconds rescan {5000};
+                                ///< Interval to poll unwatched subtrees
+  std::size_t max_watches = std::numeric_limits<std::size_t>::max();
+                                ///< Directories to watch before polling
+  std::size_t buffer_size = 64u * 1024u;
+                                ///< Bytes of events read at once
+};
+
+///
+/// Event-driven change detection for a directory tree, using inotify
+///
+/// On construction, a watch is registered on every directory in the tree.
+/// Then a thread reads the events of the tree and writes them to a fifo, of
+/// which the caller is the reader.  Directories created later are watched
+/// in turn, and their existing contents reported as created, since they may
+/// have been populated before the watch was registered.  Directories renamed
+/// within the tree keep their watches.
+///
+/// Events for a path within the coalescing delay are merged: repeated
+/// modification is reported once, creation followed by modification as
+/// creation, and creation followed by deletion not at all.
+///
+/// When a watch cannot be registered because of the inotify limit, or
+/// because \c max_watches is reached, the subtree is instead polled every
+/// \c rescan interval, comparing each entry's mtime, size, and type.
+/// If the kernel's event queue overflows, a \c rescan event is written for
+/// the root, with an empty path.  A polled subtree whose directory is
+/// removed is no longer polled.
+///
+/// If the root itself is deleted or renamed, a \c deleted or \c moved_from
+/// event is written for it, with an empty path, and the thread ends.
+///
+/// The fifo must be drained: the thread waits while it is full.  Stopping
+/// while it is full discards the oldest event, to release the thread, so
+/// \c stop must not be called while another thread reads the fifo.
+///
+struct directory_watcher {
+  using queue_type = fifo<watch_event>;
+
+  ///
+  /// @param directory Root of the tree
+  /// @param queue     Fifo to which events are written
+  /// @param options   Options for watching
+  ///
+  directory_watcher(
+      std::string directory,
+      queue_type& queue,
+      watcher_options options = {});
+
+  /// Stop watching
+  ~directory_watcher();
+
+  directory_watcher(const directory_watcher& ) = delete;
+  directory_watcher& operator=(const directory_watcher& ) = delete;
+
+  ///
+  /// Stop watching, and rethrow any exception that stopped the thread
+  ///
+  void stop();
+
+  const std::string& root() const noexcept;
+
+  /// Number of directories watched
+  std::size_t watches() const noexcept;
+
+  /// Number of subtrees polled instead of watched
+  std::size_t polled() const noexcept;
+
+private:
+  struct implementation;
+  std::unique_ptr<implementation> _impl;
+};
+
+/// @}
+
+#endif
+
+}
+
+#endif
@@ -0,0 +1,232 @@
+//
+// Copyright (c) 2026
+// Kyle Markley.  All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+// 3. Neither the name of the author nor the names of any contributors may be
+//    used to endorse or promote products derived from this software without
+//    specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include "arrtest/arrtest.hpp"
+#include "arr/directory_watcher.hpp"
+#include "arr/cstdio.hpp"
+#include "arr/fcntl.hpp"
+#include "arr/file_descriptor.hpp"
+#include "arr/temp_dir.hpp"
+#include "arr/unistd.hpp"
+#include <chrono>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+
+UNIT_TEST_MAIN
+
+using namespace arr;
+using namespace std;
+
+namespace {
+
+using strings = set<string>;
+
+void put(const string& path, const string& data) {
+  wrap::file_descriptor fd = wrap::open(SOURCE_CONTEXT,
+      path.c_str(), O_WRONLY|O_CREAT|O_APPEND, 0600);
+  wrap::write(SOURCE_CONTEXT, fd.get(), data.data(), data.size());
+}
+
+// Watched temporary directory, with events as "change path"
+struct watched {
+  explicit watched(watcher_options options = {})
+    : queue(1024)
+    , watcher(dir.name(), queue, options)
+  { }
+  string path(const string& relative) const {
+    return string(dir.name()) + '/' + relative;
+  }
+  // Gather events until those expected have arrived, or two seconds pass
+  strings wait_for(size_t expected) {
+    auto deadline = chrono::steady_clock::now() + 2s;
+    while (events.size() < expected and
+        chrono::steady_clock::now() < deadline) {
+      if (queue.empty()) {
+        this_thread::sleep_for(1ms);
+        continue;
+      }
+      auto& e = queue.front();
+      ostringstream o;
+      o << e.change << ' ' << e.path << (e.directory ? "/" : "");
+      events.insert(o.str());
+      queue.pop();
+    }
+    // Nothing further should arrive after the coalescing delay
+    this_thread::sleep_for(50ms);
+    while (not queue.empty()) {
+      events.insert("unexpected " + queue.front().path);
+      queue.pop();
+    }
+    return std::exchange(events, {});
+  }
+  temp_dir dir;
+  directory_watcher::queue_type queue;
+  directory_watcher watcher;
+  strings events;
+};
+
+}
+
+SUITE(watch) {
+
+  TEST(coalesced) {
+    watched w;
+    put(w.path("a"), "1");
+    put(w.path("a"), "2");
+    put(w.path("a"), "3");
+    CHECK_EQUAL(true, (strings{"created a"} == w.wait_for(1u)));
+    put(w.path("a"), "4");
+    put(w.path("a"), "5");
+    CHECK_EQUAL(true, (strings{"modified a"} == w.wait_for(1u)));
+    wrap::unlink(SOURCE_CONTEXT, w.path("a").c_str());
+    CHECK_EQUAL(true, (strings{"deleted a"} == w.wait_for(1u)));
+    put(w.path("b"), "1");
+    wrap::unlink(SOURCE_CONTEXT, w.path("b").c_str());
+    CHECK_EQUAL(true, (strings{} == w.wait_for(0u)));
+  }
+
+  TEST(small_buffer) {
+    // Smaller than one event with a long name, which inotify rejects
+    watcher_options options;
+    options.buffer_size = 1u;
+    watched w(options);
+    auto name = string(200u, 'n');
+    put(w.path(name), "1");
+    CHECK_EQUAL(true, (strings{"created " + name} == w.wait_for(1u)));
+  }
+
+  TEST(new_directory) {
+    watched w;
+    CHECK_EQUAL(1u, w.watcher.watches());
+    wrap::mkdir(SOURCE_CONTEXT, w.path("d").c_str(), 0700);
+    put(w.path("d/f"), "1");
+    CHECK_EQUAL(true, (strings{"created d/", "created d/f"} == w.wait_for(2u)));
+    CHECK_EQUAL(2u, w.watcher.watches());
+    put(w.path("d/f"), "2");
+    CHECK_EQUAL(true, (strings{"modified d/f"} == w.wait_for(1u)));
+  }
+
+  TEST(existing_tree) {
+    temp_dir dir;
+    auto d = string(dir.name()) + "/d";
+    wrap::mkdir(SOURCE_CONTEXT, d.c_str(), 0700);
+    wrap::mkdir(SOURCE_CONTEXT, (d + "/e").c_str(), 0700);
+    directory_watcher::queue_type queue(16);
+    directory_watcher watcher(dir.name(), queue);
+    CHECK_EQUAL(3u, watcher.watches());
+    CHECK_EQUAL(0u, watcher.polled());
+    watcher.stop();
+  }
+
+  TEST(renamed) {
+    watched w;
+    wrap::mkdir(SOURCE_CONTEXT, w.path("d").c_str(), 0700);
+    put(w.path("f"), "1");
+    CHECK_EQUAL(true, (strings{"created d/", "created f"} == w.wait_for(2u)));
+    wrap::rename(SOURCE_CONTEXT, w.path("f").c_str(), w.path("d/g").c_str());
+    CHECK_EQUAL(true,
+        (strings{"moved_from f", "moved_to d/g"} == w.wait_for(2u)));
+    wrap::rename(SOURCE_CONTEXT, w.path("d").c_str(), w.path("e").c_str());
+    CHECK_EQUAL(true,
+        (strings{"moved_from d/", "moved_to e/"} == w.wait_for(2u)));
+    // The renamed directory keeps its watch under its new name
+    put(w.path("e/g"), "2");
+    CHECK_EQUAL(true, (strings{"modified e/g"} == w.wait_for(1u)));
+  }
+
+  TEST(polled) {
+    watcher_options options;
+    options.max_watches = 1u;
+    options.rescan = 50ms;
+    watched w(options);
+    wrap::mkdir(SOURCE_CONTEXT, w.path("d").c_str(), 0700);
+    CHECK_EQUAL(true, (strings{"created d/"} == w.wait_for(1u)));
+    CHECK_EQUAL(1u, w.watcher.watches());
+    CHECK_EQUAL(1u, w.watcher.polled());
+    put(w.path("d/f"), "1");
+    CHECK_EQUAL(true, (strings{"created d/f"} == w.wait_for(1u)));
+    put(w.path("d/f"), "22");
+    CHECK_EQUAL(true, (strings{"modified d/f"} == w.wait_for(1u)));
+    wrap::unlink(SOURCE_CONTEXT, w.path("d/f").c_str());
+    CHECK_EQUAL(true, (strings{"deleted d/f"} == w.wait_for(1u)));
+    // The subtree is no longer polled once its directory is removed
+    wrap::rmdir(SOURCE_CONTEXT, w.path("d").c_str());
+    CHECK_EQUAL(true, (strings{"deleted d/"} == w.wait_for(1u)));
+    CHECK_EQUAL(0u, w.watcher.polled());
+  }
+
+  TEST(root_deleted) {
+    temp_dir dir;
+    auto root = string(dir.name()) + "/r";
+    wrap::mkdir(SOURCE_CONTEXT, root.c_str(), 0700);
+    directory_watcher::queue_type queue(16);
+    directory_watcher watcher(root, queue);
+    wrap::rmdir(SOURCE_CONTEXT, root.c_str());
+    auto deadline = chrono::steady_clock::now() + 2s;
+    while (queue.empty() and chrono::steady_clock::now() < deadline) {
+      this_thread::sleep_for(1ms);
+    }
+    CHECK_EQUAL(false, queue.empty());
+    if (not queue.empty()) {
+      CHECK_EQUAL(true, watch_change::deleted == queue.front().change);
+      CHECK_EQUAL(string(), queue.front().path);
+    }
+    watcher.stop();
+  }
+
+  TEST(stop_when_full) {
+    temp_dir dir;
+    directory_watcher::queue_type queue(2);
+    watcher_options options;
+    options.coalesce = 0ms;
+    directory_watcher watcher(dir.name(), queue, options);
+    for (int i = 0; i < 8; ++i) {
+      put(string(dir.name()) + "/f" + to_string(i), "1");
+    }
+    auto deadline = chrono::steady_clock::now() + 2s;
+    while (not queue.full() and chrono::steady_clock::now() < deadline) {
+      this_thread::sleep_for(1ms);
+    }
+    CHECK_EQUAL(true, queue.full());
+    watcher.stop();             // Returns although nothing reads the fifo
+  }
+
+}
+
+SUITE(text) {
+
+  TEST(change) {
+    ostringstream o;
+    o << watch_change::created << ' ' << watch_change::rescan;
+    CHECK_EQUAL("created rescan", o.str());
+  }
+
+}
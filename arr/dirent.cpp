@@ -1,5 +1,5 @@
 //
-// Copyright (c) 2012, 2021
+// Copyright (c) 2012, 2021, 2026
 // Kyle Markley.  All rights reserved.
 //
 // Redistribution and use in source and binary forms, with or without
@@ -30,6 +30,10 @@
 #include "arr/dirent.hpp"
 #include "arr/path_exception.hpp"
 #include <cerrno>
+#if defined(__linux__)
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 
 namespace wrap {
 
@@ -39,6 +43,12 @@ DIR * opendir(arr::source_context context, const char * filename) {
   throw arr::path_exception(context, __func__, filename);
 }
 
+DIR * fdopendir(arr::source_context context, int fd) {
+  auto r = ::fdopendir(fd);
+  if (r) return r;
+  throw arr::syscall_exception(context, __func__);
+}
+
 void closedir(arr::source_context context, DIR * dirp) {
   auto r = ::closedir(dirp);
   if (0 != r) throw arr::syscall_exception(context, __func__);
@@ -57,4 +67,19 @@ void rewinddir(arr::source_context context, DIR * dirp) {
   if (errno) throw arr::syscall_exception(context, __func__);
 }
 
+int dirfd(arr::source_context context, DIR * dirp) {
+  auto r = ::dirfd(dirp);
+  if (-1 == r) throw arr::syscall_exception(context, __func__);
+  return r;
+}
+
+#if defined(__linux__)
+size_t getdents64(arr::source_context context,
+    int fd, void * buf, size_t nbytes) {
+  auto r = ::syscall(SYS_getdents64, fd, buf, nbytes);
+  if (-1 == r) throw arr::syscall_exception(context, __func__);
+  return static_cast<size_t>(r);
+}
+#endif
+
 }
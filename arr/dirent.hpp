@@ -1,7 +1,7 @@
 #ifndef WRAP_DIRENT_HPP
 #define WRAP_DIRENT_HPP
 //
-// Copyright (c) 2012, 2021
+// Copyright (c) 2012, 2021, 2026
 // Kyle Markley.  All rights reserved.
 //
 // Redistribution and use in source and binary forms, with or without
@@ -50,6 +50,11 @@ namespace wrap {
 ///
 DIR * opendir(arr::source_context, const char * filename);
 
+///
+/// Wrapper for fdopendir(3)
+///
+DIR * fdopendir(arr::source_context, int fd);
+
 ///
 /// Wrapper for closedir(3)
 ///
@@ -65,6 +70,20 @@ struct dirent * readdir(arr::source_context, DIR * dirp);
 ///
 void rewinddir(arr::source_context, DIR * dirp);
 
+///
+/// Wrapper for dirfd(3)
+///
+int dirfd(arr::source_context, DIR * dirp);
+
+#if defined(__linux__)
+///
+/// Wrapper for getdents64(2)
+///
+/// @return Number of bytes of directory entries read, or 0 at the end
+///
+size_t getdents64(arr::source_context, int fd, void * buf, size_t nbytes);
+#endif
+
 /// @}
 
 }
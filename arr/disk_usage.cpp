@@ -0,0 +1,149 @@
+//
+// Copyright (c) 2026
+// Kyle Markley.  All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+// 3. Neither the name of the author nor the names of any contributors may be
+//    used to endorse or promote products derived from this software without
+//    specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include "arr/disk_usage.hpp"
+#include "arr/fcntl.hpp"
+#include "arr/inode_set.hpp"
+#include "arr/parallel_directory_traversal.hpp"
+#include <algorithm>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace arr {
+
+namespace {
+
+constexpr char separator = '/';
+
+usage measure(const struct stat& sb) noexcept {
+  usage u;
+  u.blocks = static_cast<std::uint64_t>(sb.st_blocks);
+  u.bytes = static_cast<std::uint64_t>(sb.st_size);
+  if (S_ISDIR(sb.st_mode)) u.directories = 1u;
+  else u.files = 1u;
+  return u;
+}
+
+/// Usage of directories, by path, as summed by one worker
+struct partial_sums {
+  std::unordered_map<std::string, usage> directories;
+  std::string current_path;             ///< Directory of \c current
+  usage * current = nullptr;
+};
+
+/// Path of the directory containing a directory, or empty at the root
+std::string_view parent(std::string_view path, std::size_t root) {
+  if (path.size() <= root) return {};
+  return path.substr(0, path.rfind(separator, path.size() - 2u) + 1u);
+}
+
+}
+
+disk_usage::disk_usage(std::string directory, disk_usage_options options)
+  : _root(std::move(directory))
+  , _options(options)
+{
+  if (_root.empty() or separator != _root.back()) _root += separator;
+}
+
+usage disk_usage::run(visitor_type visitor) {
+  struct stat root_sb;
+  wrap::fstatat(SOURCE_CONTEXT, AT_FDCWD, _root.c_str(), &root_sb, 0);
+
+  parallel_directory_traversal pdt(_root, _options.threads,
+      parallel_directory_traversal::visit_type::all, _options.directory);
+  std::vector<partial_sums> sums(pdt.threads());
+  std::mutex lock;              // Guards links and exceptions
+  inode_set links;
+  pdt.run([&](const parallel_directory_entry& e) {
+    struct stat sb;
+    try {
+      wrap::fstatat(SOURCE_CONTEXT, e.dir_fd, e.entry.d_name, &sb,
+          AT_SYMLINK_NOFOLLOW);
+    } catch (syscall_exception& x) {
+      e.descend = false;
+      std::lock_guard<std::mutex> guard(lock);
+      exceptions.emplace_back(x.clone());
+      return;
+    }
+    auto& mine = sums[e.worker];
+    if (S_ISDIR(sb.st_mode)) {
+      if (_options.one_filesystem and root_sb.st_dev != sb.st_dev) {
+        e.descend = false;
+        return;
+      }
+      // Counted as part of the subdirectory itself
+      mine.directories[e.path() + separator] += measure(sb);
+      return;
+    }
+    if (not _options.count_links and sb.st_nlink > 1) {
+      std::lock_guard<std::mutex> guard(lock);
+      if (not links.insert(sb.st_dev, sb.st_ino)) return;
+    }
+    if (not mine.current or e.directory.path() != mine.current_path) {
+      mine.current_path = e.directory.path();
+      mine.current = &mine.directories[mine.current_path];
+    }
+    *mine.current += measure(sb);
+  });
+  exceptions.splice(exceptions.end(), pdt.exceptions);
+
+  // Merge the workers' sums
+  auto totals = std::move(sums.front().directories);
+  for (std::size_t i = 1; i < sums.size(); ++i) {
+    for (auto& [path, u] : sums[i].directories) totals[path] += u;
+  }
+  totals[_root] += measure(root_sb);
+
+  // Post-order is path order, except that a directory follows its contents
+  std::vector<std::pair<const std::string, usage> *> order;
+  order.reserve(totals.size());
+  for (auto& t : totals) order.push_back(&t);
+  std::sort(order.begin(), order.end(), [](auto a, auto b) {
+    auto& x = a->first;
+    auto& y = b->first;
+    auto n = std::min(x.size(), y.size());
+    auto c = x.compare(0, n, y, 0, n);
+    if (c) return c < 0;
+    return x.size() > y.size();
+  });
+
+  // Roll each directory up into its parent, contents first
+  for (auto p : order) {
+    auto& [path, total] = *p;
+    if (visitor) visitor(path, total);
+    auto up = parent(path, _root.size());
+    if (not up.empty()) totals[std::string(up)] += total;
+  }
+  return totals[_root];
+}
+
+}
@@ -0,0 +1,120 @@
+#ifndef ARR_DISK_USAGE_HPP
+#define ARR_DISK_USAGE_HPP
+//
+// Copyright (c) 2026
+// Kyle Markley.  All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+// 3. Neither the name of the author nor the names of any contributors may be
+//    used to endorse or promote products derived from this software without
+//    specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include "arr/directory_sequence.hpp"
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <string>
+
+namespace arr {
+
+/// \addtogroup directory_traversal
+/// @{
+
+///
+/// Space used by a directory tree
+///
+struct usage {
+  std::uint64_t blocks = 0u;        ///< 512-byte blocks allocated
+  std::uint64_t bytes = 0u;         ///< Apparent size
+  std::uint64_t files = 0u;         ///< Non-directories
+  std::uint64_t directories = 0u;   ///< Directories, including the root
+
+  usage& operator+=(const usage& peer) noexcept {
+    blocks      += peer.blocks;
+    bytes       += peer.bytes;
+    files       += peer.files;
+    directories += peer.directories;
+    return *this;
+  }
+};
+
+///
+/// Options for a disk_usage measurement
+///
+struct disk_usage_options {
+  unsigned threads = 0u;            ///< Worker threads (0 for the CPUs)
+  bool one_filesystem = false;      ///< Skip directories on other filesystems
+  bool count_links = false;         ///< Count a file with several links
+                                    ///< under each of its names
+  directory_options directory = {}; ///< Options for reading directories
+};
+
+///
+/// Parallel measurement of the space used by a directory tree, as by du
+///
+/// The tree is read by a \c parallel_directory_traversal, and each entry is
+/// measured with fstatat relative to its directory's descriptor, without
+/// following symbolic links.  Each worker sums the usage of the directories
+/// it reads, and the sums are merged and rolled up into every ancestor when
+/// the traversal ends.
+///
+/// As by du, a file with several links is counted once, under the first name
+/// found, unless \c count_links.  Only such files are remembered for this,
+/// in a set shared under a mutex.  With \c one_filesystem, a directory on
+/// another filesystem than the root is neither counted nor descended into.
+///
+struct disk_usage {
+  using visitor_type =
+    std::function<void(const std::string& path, const usage& total)>;
+
+  disk_usage(std::string directory, disk_usage_options options = {});
+
+  ///
+  /// Measure the tree
+  ///
+  /// @param visitor Called as \c visitor(path,total) for each directory, in
+  ///                post-order, with the path ending in a separator
+  /// @return Usage of the whole tree
+  ///
+  /// The visitor is called from the calling thread after the traversal.
+  ///
+  usage run(visitor_type visitor = {});
+
+  const std::string& root() const noexcept { return _root; }
+
+  ///
+  /// Exceptions encountered during directory traversal
+  ///
+  std::list<std::unique_ptr<syscall_exception>> exceptions;
+
+private:
+  std::string _root;
+  disk_usage_options _options;
+};
+
+/// @}
+
+}
+
+#endif
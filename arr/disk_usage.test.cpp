@@ -0,0 +1,146 @@
+//
+// Copyright (c) 2026
+// Kyle Markley.  All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+// 3. Neither the name of the author nor the names of any contributors may be
+//    used to endorse or promote products derived from this software without
+//    specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include "arrtest/arrtest.hpp"
+#include "arr/disk_usage.hpp"
+#include "arr/fcntl.hpp"
+#include "arr/file_descriptor.hpp"
+#include "arr/recursive_directory_sequence.hpp"
+#include "arr/temp_dir.hpp"
+#include "arr/unistd.hpp"
+#include <iostream>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+UNIT_TEST_MAIN
+
+using namespace arr;
+using namespace std;
+
+namespace {
+
+void put(const string& path, size_t size) {
+  wrap::file_descriptor fd = wrap::open(SOURCE_CONTEXT,
+      path.c_str(), O_WRONLY|O_CREAT|O_TRUNC, 0600);
+  string data(size, 'x');
+  if (size) wrap::write(SOURCE_CONTEXT, fd.get(), data.data(), data.size());
+}
+
+// Root with files of 100 and 200 bytes, d with 300 bytes and a hard link to
+// the file of 200, d/e with 400 bytes, and an empty directory f
+struct tree {
+  tree() : root(string(dir.name()) + "/r") {
+    wrap::mkdir(SOURCE_CONTEXT, root.c_str(), 0700);
+    wrap::mkdir(SOURCE_CONTEXT, (root + "/d").c_str(), 0700);
+    wrap::mkdir(SOURCE_CONTEXT, (root + "/d/e").c_str(), 0700);
+    wrap::mkdir(SOURCE_CONTEXT, (root + "/f").c_str(), 0700);
+    put(root + "/a", 100u);
+    put(root + "/b", 200u);
+    put(root + "/d/c", 300u);
+    put(root + "/d/e/g", 400u);
+    ::link((root + "/b").c_str(), (root + "/d/h").c_str());
+  }
+  // Sum of the sizes of all directories, as stat reports them
+  uint64_t directory_bytes(const string& sub = "") const {
+    struct stat sb;
+    uint64_t sum = 0;
+    for (auto d : { "", "/d", "/d/e", "/f" }) {
+      if (0 != string(d).compare(0, sub.size(), sub)) continue;
+      wrap::fstatat(SOURCE_CONTEXT, AT_FDCWD, (root + d).c_str(), &sb, 0);
+      sum += static_cast<uint64_t>(sb.st_size);
+    }
+    return sum;
+  }
+  temp_dir dir;
+  string root;
+};
+
+}
+
+SUITE(measurement) {
+
+  TEST(totals) {
+    tree t;
+    for (unsigned threads : { 1u, 2u, 4u }) {
+      disk_usage_options options;
+      options.threads = threads;
+      disk_usage du(t.root, options);
+      auto total = du.run();
+      CHECK_EQUAL(4u, total.files);
+      CHECK_EQUAL(4u, total.directories);
+      CHECK_EQUAL(1000u + t.directory_bytes(), total.bytes);
+      CHECK_EQUAL(true, total.blocks > 0u);
+      CHECK_EQUAL(true, du.exceptions.empty());
+    }
+  }
+
+  TEST(count_links) {
+    tree t;
+    disk_usage_options options;
+    options.count_links = true;
+    auto total = disk_usage(t.root, options).run();
+    CHECK_EQUAL(5u, total.files);
+    CHECK_EQUAL(1200u + t.directory_bytes(), total.bytes);
+  }
+
+  TEST(post_order) {
+    tree t;
+    vector<string> paths;
+    vector<usage> totals;
+    disk_usage du(t.root);
+    auto total = du.run([&](const string& path, const usage& u) {
+      cout << path << ' ' << u.bytes << endl;
+      paths.push_back(path.substr(t.root.size()));
+      totals.push_back(u);
+    });
+    CHECK_EQUAL(true,
+        (vector<string>{ "/d/e/", "/d/", "/f/", "/" }) == paths);
+    if (4u != totals.size()) return;
+    CHECK_EQUAL(1u, totals[0].files);
+    CHECK_EQUAL(400u + t.directory_bytes("/d/e"), totals[0].bytes);
+    // The hard link is counted under the first name found, in either place
+    auto d = totals[1].bytes - t.directory_bytes("/d");
+    CHECK_EQUAL(true, 700u == d or 900u == d);
+    CHECK_EQUAL(1u, totals[2].directories);
+    CHECK_EQUAL(true, total.bytes == totals[3].bytes);
+    CHECK_EQUAL(4u, totals[3].directories);
+  }
+
+  TEST(missing) {
+    temp_dir dir;
+    try {
+      disk_usage(string(dir.name()) + "/missing").run();
+      CHECK(0);
+    } catch (syscall_exception& e) {
+      CHECK_EQUAL(true, e.code() == std::errc::no_such_file_or_directory);
+    }
+  }
+
+}
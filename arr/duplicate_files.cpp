@@ -0,0 +1,312 @@
+//
+// Copyright (c) 2026
+// Kyle Markley.  All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+// 3. Neither the name of the author nor the names of any contributors may be
+//    used to endorse or promote products derived from this software without
+//    specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include "arr/duplicate_files.hpp"
+#include "arr/fcntl.hpp"
+#include "arr/file_descriptor.hpp"
+#include "arr/inode_set.hpp"
+#include "arr/memory_map.hpp"
+#include "arr/mman.hpp"
+#include "arr/parallel_directory_traversal.hpp"
+#include "arr/unistd.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace arr {
+
+namespace {
+
+constexpr std::uint64_t prime1 = 0x9E3779B185EBCA87u;
+constexpr std::uint64_t prime2 = 0xC2B2AE3D27D4EB4Fu;
+constexpr std::uint64_t prime3 = 0x165667B19E3779F9u;
+constexpr std::uint64_t prime4 = 0x85EBCA77C2B2AE63u;
+constexpr std::uint64_t prime5 = 0x27D4EB2F165667C5u;
+constexpr std::size_t stripe = 32u;
+
+constexpr std::uint64_t rotl(std::uint64_t x, int r) noexcept {
+  return (x << r) | (x >> (64 - r));
+}
+
+template <typename T> T load(const unsigned char * p) noexcept {
+  T v;
+  std::memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+constexpr std::uint64_t mix(std::uint64_t acc, std::uint64_t input) noexcept {
+  return rotl(acc + input * prime2, 31) * prime1;
+}
+
+constexpr std::uint64_t merge(std::uint64_t acc, std::uint64_t lane) noexcept {
+  return (acc ^ mix(0u, lane)) * prime1 + prime4;
+}
+
+void consume(std::uint64_t (&lanes)[4], const unsigned char * p) noexcept {
+  for (auto& lane : lanes) {
+    lane = mix(lane, load<std::uint64_t>(p));
+    p += 8;
+  }
+}
+
+/// File that may have a duplicate
+struct candidate {
+  std::uint64_t size;
+  std::string path;
+  std::uint64_t hash = 0u;
+  bool hashed = false;
+};
+
+/// Hash a file by reading or mapping it
+std::uint64_t hash_file(const candidate& c, const duplicate_options& options,
+    std::vector<unsigned char>& buffer, std::uint64_t& bytes) {
+  wrap::file_descriptor fd = wrap::open(SOURCE_CONTEXT,
+      c.path.c_str(), O_RDONLY|O_CLOEXEC, 0);
+  content_hash h;
+  if (options.map_threshold and c.size >= options.map_threshold) {
+    auto length = static_cast<std::size_t>(c.size);
+    wrap::memory_map map(wrap::mmap(SOURCE_CONTEXT,
+          nullptr, length, PROT_READ, MAP_PRIVATE, fd.get(), 0), length);
+    ::madvise(map.get(), length, MADV_SEQUENTIAL);
+    h.update(map.get(), length);
+    bytes += length;
+    return h.digest();
+  }
+  ::posix_fadvise(fd.get(), 0, 0, POSIX_FADV_SEQUENTIAL);
+  for (;;) {
+    auto n = wrap::read(SOURCE_CONTEXT, fd.get(), buffer.data(), buffer.size());
+    if (0u == n) break;
+    h.update(buffer.data(), n);
+    bytes += n;
+  }
+  return h.digest();
+}
+
+}
+
+content_hash::content_hash() noexcept
+  : _lanes{prime1 + prime2, prime2, 0u, 0u - prime1}
+{ }
+
+void content_hash::update(const void * data, std::size_t size) noexcept {
+  auto p = static_cast<const unsigned char *>(data);
+  _total += size;
+  if (_stripe_size + size < stripe) {
+    std::memcpy(_stripe + _stripe_size, p, size);
+    _stripe_size += size;
+    return;
+  }
+  if (_stripe_size) {
+    auto fill = stripe - _stripe_size;
+    std::memcpy(_stripe + _stripe_size, p, fill);
+    consume(_lanes, _stripe);
+    p += fill;
+    size -= fill;
+    _stripe_size = 0u;
+  }
+  for (; size >= stripe; p += stripe, size -= stripe) consume(_lanes, p);
+  std::memcpy(_stripe, p, size);
+  _stripe_size = size;
+}
+
+std::uint64_t content_hash::digest() const noexcept {
+  std::uint64_t h;
+  if (_total >= stripe) {
+    h = rotl(_lanes[0], 1) + rotl(_lanes[1], 7) +
+      rotl(_lanes[2], 12) + rotl(_lanes[3], 18);
+    for (auto lane : _lanes) h = merge(h, lane);
+  } else {
+    h = prime5;
+  }
+  h += _total;
+  auto p = _stripe;
+  auto left = _stripe_size;
+  for (; left >= 8u; p += 8, left -= 8u) {
+    h ^= mix(0u, load<std::uint64_t>(p));
+    h = rotl(h, 27) * prime1 + prime4;
+  }
+  if (left >= 4u) {
+    h ^= std::uint64_t(load<std::uint32_t>(p)) * prime1;
+    h = rotl(h, 23) * prime2 + prime3;
+    p += 4;
+    left -= 4u;
+  }
+  for (; left; ++p, --left) {
+    h ^= *p * prime5;
+    h = rotl(h, 11) * prime1;
+  }
+  h ^= h >> 33;
+  h *= prime2;
+  h ^= h >> 29;
+  h *= prime3;
+  h ^= h >> 32;
+  return h;
+}
+
+duplicate_files::duplicate_files(std::string directory,
+    duplicate_options options)
+  : _root(std::move(directory))
+  , _options(options)
+{ }
+
+std::size_t duplicate_files::run(visitor_type visitor) {
+  files = files_hashed = bytes_hashed = 0u;
+  struct stat root_sb;
+  wrap::fstatat(SOURCE_CONTEXT, AT_FDCWD, _root.c_str(), &root_sb, 0);
+
+  //
+  // Find the regular files and their sizes
+  //
+  parallel_directory_traversal pdt(_root, _options.threads,
+      parallel_directory_traversal::visit_type::all, _options.directory);
+  std::vector<std::vector<candidate>> found(pdt.threads());
+  std::mutex lock;              // Guards links and exceptions
+  inode_set links;
+  pdt.run([&](const parallel_directory_entry& e) {
+    auto type = e.entry.d_type;
+    if (DT_REG != type and not (DT_DIR == type and _options.one_filesystem)) {
+      return;
+    }
+    struct stat sb;
+    try {
+      wrap::fstatat(SOURCE_CONTEXT, e.dir_fd, e.entry.d_name, &sb,
+          AT_SYMLINK_NOFOLLOW);
+    } catch (syscall_exception& x) {
+      e.descend = false;
+      std::lock_guard<std::mutex> guard(lock);
+      exceptions.emplace_back(x.clone());
+      return;
+    }
+    if (S_ISDIR(sb.st_mode)) {
+      if (root_sb.st_dev != sb.st_dev) e.descend = false;
+      return;
+    }
+    auto size = static_cast<std::uint64_t>(sb.st_size);
+    if (not S_ISREG(sb.st_mode) or size < _options.min_size) return;
+    if (not _options.count_links and sb.st_nlink > 1) {
+      std::lock_guard<std::mutex> guard(lock);
+      if (not links.insert(sb.st_dev, sb.st_ino)) return;
+    }
+    found[e.worker].push_back(candidate{size, e.path()});
+  });
+  exceptions.splice(exceptions.end(), pdt.exceptions);
+
+  //
+  // Keep only files sharing their size with another, largest first
+  //
+  std::vector<candidate> candidates;
+  for (auto& f : found) {
+    files += f.size();
+    std::move(f.begin(), f.end(), std::back_inserter(candidates));
+    f = {};
+  }
+  std::sort(candidates.begin(), candidates.end(),
+      [](const candidate& a, const candidate& b) { return a.size > b.size; });
+  auto shared = [&](std::size_t i) {
+    auto size = candidates[i].size;
+    return (i > 0u and candidates[i - 1u].size == size) or
+      (i + 1u < candidates.size() and candidates[i + 1u].size == size);
+  };
+  std::size_t kept = 0u;
+  for (std::size_t i = 0; i < candidates.size(); ++i) {
+    if (shared(i)) {
+      if (kept != i) candidates[kept] = std::move(candidates[i]);
+      ++kept;
+    }
+  }
+  candidates.resize(kept);
+  files_hashed = kept;
+
+  //
+  // Hash them, each thread taking the next file
+  //
+  std::atomic<std::size_t> next {0u};
+  std::atomic<std::uint64_t> bytes {0u};
+  auto hash = [&] {
+    std::vector<unsigned char> buffer(std::max<std::size_t>(
+          stripe, _options.buffer_size / stripe * stripe));
+    std::uint64_t mine = 0u;
+    for (;;) {
+      auto i = next.fetch_add(1u, std::memory_order::relaxed);
+      if (i >= candidates.size()) break;
+      auto& c = candidates[i];
+      try {
+        c.hash = hash_file(c, _options, buffer, mine);
+        c.hashed = true;
+      } catch (syscall_exception& x) {
+        std::lock_guard<std::mutex> guard(lock);
+        exceptions.emplace_back(x.clone());
+      }
+    }
+    bytes.fetch_add(mine, std::memory_order::relaxed);
+  };
+  auto depth = std::min<std::size_t>(std::max(1u, _options.io_depth),
+      std::max<std::size_t>(1u, candidates.size()));
+  std::vector<std::thread> threads;
+  for (std::size_t i = 1; i < depth; ++i) threads.emplace_back(hash);
+  hash();
+  for (auto& t : threads) t.join();
+  bytes_hashed = bytes.load();
+
+  //
+  // Group files of the same size by hash
+  //
+  std::stable_sort(candidates.begin(), candidates.end(),
+      [](const candidate& a, const candidate& b) {
+        if (a.size != b.size) return a.size > b.size;
+        return a.hash < b.hash;
+      });
+  std::size_t groups = 0u;
+  duplicate_group group;
+  for (std::size_t i = 0; i < candidates.size(); ) {
+    auto j = i;
+    while (j < candidates.size() and candidates[j].size == candidates[i].size
+        and candidates[j].hash == candidates[i].hash) {
+      ++j;
+    }
+    group.paths.clear();
+    for (auto k = i; k < j; ++k) {
+      if (candidates[k].hashed) group.paths.push_back(candidates[k].path);
+    }
+    if (group.paths.size() > 1u) {
+      group.size = candidates[i].size;
+      group.hash = candidates[i].hash;
+      std::sort(group.paths.begin(), group.paths.end());
+      ++groups;
+      if (visitor) visitor(group);
+    }
+    i = j;
+  }
+  return groups;
+}
+
+}
@@ -0,0 +1,161 @@
+#ifndef ARR_DUPLICATE_FILES_HPP
+#define ARR_DUPLICATE_FILES_HPP
+//
+// Copyright (c) 2026
+// Kyle Markley.  All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+// 3. Neither the name of the author nor the names of any contributors may be
+//    used to endorse or promote products derived from this software without
+//    specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include "arr/directory_sequence.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace arr {
+
+/// \addtogroup directory_traversal
+/// @{
+
+///
+/// Incremental 64-bit content hash
+///
+/// This is XXH64 with a seed of zero: fast and well-distributed, but not
+/// cryptographic.  Words are read in native byte order, so digests match the
+/// reference implementation on little-endian machines.
+///
+struct content_hash {
+  content_hash() noexcept;
+
+  /// Add bytes to the hashed content
+  void update(const void * data, std::size_t size) noexcept;
+
+  /// Hash of the content so far
+  std::uint64_t digest() const noexcept;
+
+private:
+  std::uint64_t _lanes[4];
+  std::uint64_t _total = 0u;
+  unsigned char _stripe[32];    ///< Bytes not yet forming a whole stripe
+  std::size_t _stripe_size = 0u;
+};
+
+///
+/// Files found to have the same content
+///
+struct duplicate_group {
+  std::uint64_t size = 0u;          ///< Size of each file
+  std::uint64_t hash = 0u;          ///< \c content_hash of each file
+  std::vector<std::string> paths;   ///< Paths of the files, sorted
+};
+
+///
+/// Options for a duplicate_files search
+///
+struct duplicate_options {
+  unsigned threads = 0u;            ///< Threads reading directories
+                                    ///< (0 for the CPUs)
+  unsigned io_depth = 4u;           ///< Files hashed at once, each by a
+                                    ///< thread of its own
+  std::size_t buffer_size = 1024u * 1024u;
+                                    ///< Bytes per read of a file
+  std::uint64_t map_threshold = 64u * 1024u * 1024u;
+                                    ///< Size from which a file is mapped
+                                    ///< rather than read (0 to never map)
+  std::uint64_t min_size = 1u;      ///< Smallest file considered
+  bool one_filesystem = false;      ///< Skip directories on other filesystems
+  bool count_links = false;         ///< Consider each name of a file with
+                                    ///< several links separately
+  directory_options directory = {}; ///< Options for reading directories
+};
+
+///
+/// Parallel search for regular files with the same content
+///
+/// The search proceeds in stages:
+///   -# The tree is read by a \c parallel_directory_traversal, and each
+///      regular file is measured with fstatat relative to its directory's
+///      descriptor.
+///   -# Files are grouped by size, and a file whose size is unique cannot
+///      have a duplicate, so it is never opened.
+///   -# The remaining files are hashed by \c io_depth threads, largest
+///      first, each file read sequentially in \c buffer_size blocks or, from
+///      \c map_threshold, through a memory mapping.
+///   -# Files of the same size and hash form a group.
+///
+/// Files are taken to be equal when their hashes are; with a 64-bit hash,
+/// a false match is improbable but not impossible, and a caller about to
+/// remove files should compare them first.
+///
+/// A file with several links is considered once, under the first name
+/// found, unless \c count_links, since its names share the same storage.
+/// A file that cannot be measured or read is left out, and the exception
+/// is recorded.
+///
+struct duplicate_files {
+  using visitor_type = std::function<void(const duplicate_group& group)>;
+
+  duplicate_files(std::string directory, duplicate_options options = {});
+
+  ///
+  /// Search the tree
+  ///
+  /// @param visitor Called as \c visitor(group) for each group of two or
+  ///                more files, largest files first
+  /// @return Number of groups
+  ///
+  /// The visitor is called from the calling thread after all files are
+  /// hashed.
+  ///
+  std::size_t run(visitor_type visitor);
+
+  const std::string& root() const noexcept { return _root; }
+
+  /// @name Statistics of the last run
+  /// @{
+  std::uint64_t files = 0u;         ///< Regular files considered
+  std::uint64_t files_hashed = 0u;  ///< Files sharing a size with another
+  std::uint64_t bytes_hashed = 0u;  ///< Bytes read to hash them
+  /// @}
+
+  ///
+  /// Exceptions encountered during the search
+  ///
+  std::list<std::unique_ptr<syscall_exception>> exceptions;
+
+private:
+  std::string _root;
+  duplicate_options _options;
+};
+
+/// @}
+
+}
+
+#endif
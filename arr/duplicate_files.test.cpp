@@ -0,0 +1,162 @@
+//
+// Copyright (c) 2026
+// Kyle Markley.  All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+// 3. Neither the name of the author nor the names of any contributors may be
+//    used to endorse or promote products derived from this software without
+//    specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include "arrtest/arrtest.hpp"
+#include "arr/duplicate_files.hpp"
+#include "arr/fcntl.hpp"
+#include "arr/file_descriptor.hpp"
+#include "arr/temp_dir.hpp"
+#include "arr/unistd.hpp"
+#include <algorithm>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+UNIT_TEST_MAIN
+
+using namespace arr;
+using namespace std;
+
+namespace {
+
+void put(const string& path, const string& data) {
+  wrap::file_descriptor fd = wrap::open(SOURCE_CONTEXT,
+      path.c_str(), O_WRONLY|O_CREAT|O_TRUNC, 0600);
+  if (not data.empty()) {
+    wrap::write(SOURCE_CONTEXT, fd.get(), data.data(), data.size());
+  }
+}
+
+uint64_t hash_of(const string& data) {
+  content_hash h;
+  h.update(data.data(), data.size());
+  return h.digest();
+}
+
+// Root with a and d/b alike, c of the same size but different, e alone in
+// size, empty files f and g, and h a hard link to a
+struct tree {
+  tree() : root(string(dir.name()) + "/r") {
+    wrap::mkdir(SOURCE_CONTEXT, root.c_str(), 0700);
+    wrap::mkdir(SOURCE_CONTEXT, (root + "/d").c_str(), 0700);
+    put(root + "/a", big('x'));
+    put(root + "/d/b", big('x'));
+    put(root + "/c", big('y'));
+    put(root + "/e", "unique");
+    put(root + "/f", "");
+    put(root + "/g", "");
+    ::link((root + "/a").c_str(), (root + "/h").c_str());
+  }
+  static string big(char c) { return string(100000u, c) + "tail"; }
+  vector<duplicate_group> run(duplicate_options options = {}) {
+    duplicate_files df(root, options);
+    vector<duplicate_group> groups;
+    auto n = df.run([&](const duplicate_group& g) { groups.push_back(g); });
+    CHECK_EQUAL(n, groups.size());
+    CHECK_EQUAL(0u, df.exceptions.size());
+    return groups;
+  }
+  temp_dir dir;
+  string root;
+};
+
+}
+
+SUITE(hashing) {
+
+  TEST(reference) {
+    CHECK_EQUAL(0xEF46DB3751D8E999u, hash_of(""));
+    CHECK_EQUAL(0xD24EC4F1A98C6E5Bu, hash_of("a"));
+    CHECK_EQUAL(0x44BC2CF5AD770999u, hash_of("abc"));
+    string bytes;
+    for (int i = 0; i < 1280; ++i) bytes += static_cast<char>(i % 256);
+    CHECK_EQUAL(0xAFC184AD7938A354u, hash_of(bytes));
+  }
+
+  TEST(incremental) {
+    string data(1000u, 'q');
+    for (size_t i = 0; i < data.size(); ++i) data[i] = char(i * 7u);
+    for (size_t piece : { 1u, 5u, 31u, 32u, 33u, 999u }) {
+      content_hash h;
+      for (size_t i = 0; i < data.size(); i += piece) {
+        h.update(data.data() + i, min(piece, data.size() - i));
+      }
+      CHECK_EQUAL(hash_of(data), h.digest());
+    }
+  }
+
+}
+
+SUITE(duplicates) {
+
+  TEST(groups) {
+    tree t;
+    auto groups = t.run();
+    CHECK_EQUAL(1u, groups.size());
+    CHECK_EQUAL(100004u, groups[0].size);
+    CHECK_EQUAL(hash_of(tree::big('x')), groups[0].hash);
+    CHECK_EQUAL(2u, groups[0].paths.size());
+    auto& paths = groups[0].paths;
+    CHECK_EQUAL(true, paths.end() != find(paths.begin(), paths.end(),
+          t.root + "/d/b"));
+  }
+
+  TEST(links_and_empty) {
+    tree t;
+    duplicate_options options;
+    options.count_links = true;
+    options.min_size = 0u;
+    auto groups = t.run(options);
+    CHECK_EQUAL(2u, groups.size());
+    CHECK_EQUAL(3u, groups[0].paths.size());
+    CHECK_EQUAL(true, (groups[1].paths ==
+          vector<string>{t.root + "/f", t.root + "/g"}));
+  }
+
+  TEST(mapped) {
+    tree t;
+    duplicate_options options;
+    options.map_threshold = 1u;
+    options.io_depth = 1u;
+    options.threads = 1u;
+    auto groups = t.run(options);
+    CHECK_EQUAL(1u, groups.size());
+    CHECK_EQUAL(hash_of(tree::big('x')), groups[0].hash);
+  }
+
+  TEST(statistics) {
+    tree t;
+    duplicate_files df(t.root);
+    df.run({});
+    CHECK_EQUAL(4u, df.files);
+    CHECK_EQUAL(3u, df.files_hashed);
+    CHECK_EQUAL(3u * 100004u, df.bytes_hashed);
+  }
+
+}
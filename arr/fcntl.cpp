@@ -1,5 +1,5 @@
 //
-// Copyright (c) 2012, 2021
+// Copyright (c) 2012, 2021, 2026
 // Kyle Markley.  All rights reserved.
 //
 // Redistribution and use in source and binary forms, with or without
@@ -42,12 +42,38 @@ void lstat(arr::source_context context, const char *path, struct stat *sb) {
   if (0 != r) throw arr::path_exception(context, __func__, path);
 }
 
+void fstat(arr::source_context context, int fd, struct stat *sb) {
+  auto r = ::fstat(fd, sb);
+  if (0 != r) throw arr::syscall_exception(context, __func__);
+}
+
+void fstatat(arr::source_context context,
+    int fd, const char *path, struct stat *sb, int flag) {
+  auto r = ::fstatat(fd, path, sb, flag);
+  if (0 != r) throw arr::path_exception(context, __func__, path);
+}
+
+#if defined(__linux__)
+void statx(arr::source_context context,
+    int fd, const char *path, int flags, unsigned mask, struct statx *sb) {
+  auto r = ::statx(fd, path, flags, mask, sb);
+  if (0 != r) throw arr::path_exception(context, __func__, path);
+}
+#endif
+
 int open(arr::source_context context, const char *path, int flags, mode_t mode) {
   auto r = ::open(path, flags, mode);
   if (-1 == r) throw arr::path_exception(context, __func__, path);
   return r;
 }
 
+int openat(arr::source_context context,
+    int fd, const char *path, int flags, mode_t mode) {
+  auto r = ::openat(fd, path, flags, mode);
+  if (-1 == r) throw arr::path_exception(context, __func__, path);
+  return r;
+}
+
 void mkdir(arr::source_context context, const char *path, mode_t mode) {
   auto r = ::mkdir(path, mode);
   if (0 != r) throw arr::path_exception(context, __func__, path);
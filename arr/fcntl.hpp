@@ -1,7 +1,7 @@
 #ifndef WRAP_FCNTL_HPP
 #define WRAP_FCNTL_HPP
 //
-// Copyright (c) 2012, 2021
+// Copyright (c) 2012, 2021, 2026
 // Kyle Markley.  All rights reserved.
 //
 // Redistribution and use in source and binary forms, with or without
@@ -56,11 +56,36 @@ void stat(arr::source_context, const char *path, struct stat *sb);
 ///
 void lstat(arr::source_context, const char *path, struct stat *sb);
 
+///
+/// Wrapper for fstat(2)
+///
+void fstat(arr::source_context, int fd, struct stat *sb);
+
+///
+/// Wrapper for fstatat(2)
+///
+void fstatat(arr::source_context,
+    int fd, const char *path, struct stat *sb, int flag);
+
+#if defined(__linux__)
+///
+/// Wrapper for statx(2)
+///
+void statx(arr::source_context,
+    int fd, const char *path, int flags, unsigned mask, struct statx *sb);
+#endif
+
 ///
 /// Wrapper for open(2)
 ///
 int open(arr::source_context, const char *path, int flags, mode_t mode);
 
+///
+/// Wrapper for openat(2)
+///
+int openat(arr::source_context,
+    int fd, const char *path, int flags, mode_t mode);
+
 ///
 /// Wrapper for mkdir(2)
 ///
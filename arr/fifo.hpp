@@ -1,7 +1,7 @@
 #ifndef ARR_FIFO_HPP
 #define ARR_FIFO_HPP
 //
-// Copyright (c) 2013, 2015, 2016, 2021, 2023
+// Copyright (c) 2013, 2015, 2016, 2021, 2023, 2026
 // Kyle Markley.  All rights reserved.
 //
 // Redistribution and use in source and binary forms, with or without
@@ -32,6 +32,7 @@
 #include "arr/buffer_base.hpp"
 #include "arr/buffer_direction.hpp"
 #include "arr/buffer_transfer.hpp"
+#include "arr/fifo_statistics.hpp"
 #include <type_traits>
 #include <algorithm>
 
@@ -56,8 +57,14 @@ namespace arr {
 /// transferred before the exception is available from \c last_read_size and
 /// \c last_write_size.
 ///
+/// \par Instrumentation
+///
+/// Occupancy and stall statistics are recorded when \c S is
+/// \c fifo_statistics<true>.  By default they are compiled out.
+///
 template <typename T, unsigned align = 64u,
-         typename A = std::allocator<T>>
+         typename A = std::allocator<T>,
+         typename S = fifo_statistics<false>>
 struct fifo : private buffer_base<T,A> {
   using base = buffer_base<T,A>;
   using value_type = T;
@@ -69,6 +76,7 @@ struct fifo : private buffer_base<T,A> {
   using       reference =       value_type&;
   using const_reference = const value_type&;
   using direction_data = buffer_direction<size_type>;
+  using statistics = S;
 
   fifo(
       size_type count,
@@ -100,21 +108,26 @@ struct fifo : private buffer_base<T,A> {
   auto write_total() const noexcept { return _write.total(); }
   void wait_for_write(size_type old,
       std::memory_order order = std::memory_order::seq_cst) noexcept {
+    if constexpr (statistics::is_enabled) _stats.reader_parked();
     _write.wait(old, order);
   }
   void wait_for_write(
       std::memory_order order = std::memory_order::seq_cst) noexcept {
-    _write.wait(read_total(), order);
+    wait_for_write(read_total(), order);
   }
   void wait_for_read(size_type old,
       std::memory_order order = std::memory_order::seq_cst) noexcept {
+    if constexpr (statistics::is_enabled) _stats.writer_parked();
     _read.wait(old, order);
   }
   void wait_for_read(
       std::memory_order order = std::memory_order::seq_cst) noexcept {
-    _read.wait(write_total() - capacity(), order);
+    wait_for_read(write_total() - capacity(), order);
   }
 
+  /// Instrumentation selected by \c S
+  const statistics& get_statistics() const noexcept { return _stats; }
+
   ///
   /// @name Iterators
   /// @{
@@ -330,16 +343,21 @@ struct fifo : private buffer_base<T,A> {
   /// emplace onto a full fifo.
   ///
   void clear() { discard(space_used()); }
-  void pop() { contiguous_discard(1u); }
-  void push(const value_type&  value) { contiguous_write(&value, 1u); }
+  void pop() { contiguous_discard(1u); record_read(1u); }
+  void push(const value_type&  value) {
+    contiguous_write(&value, 1u);
+    record_write(1u);
+  }
   void push(      value_type&& value) {
     contiguous_write(std::make_move_iterator(&value), 1u);
+    record_write(1u);
   }
   template <typename ... Args>
   void emplace(Args&&... args) {
     auto ptr = elements + _write.offset();
     allocator_traits::construct(allocator, ptr, std::forward<Args>(args)...);
     _write.increase_weak(1u, capacity(), _policy);
+    record_write(1u);
   }
   /// @}
 
@@ -453,16 +471,31 @@ struct fifo : private buffer_base<T,A> {
     return xfer.write(src, num);
   }
 
+  /// Record a completed read in the instrumentation
+  void record_read(size_type num) noexcept {
+    if constexpr (statistics::is_enabled) {
+      _stats.read(num, size(), 0u != _read.waiters());
+    }
+  }
+
+  /// Record a completed write in the instrumentation
+  void record_write(size_type num) noexcept {
+    if constexpr (statistics::is_enabled) {
+      _stats.wrote(num, size(), capacity(), 0u != _write.waiters());
+    }
+  }
+
   using base::allocator;
   using base::elements;
   wake_policy _policy;
   alignas(align) direction_data _read;
   alignas(align) direction_data _write;
+  [[no_unique_address]] statistics _stats;
 };
 
-template <typename T, unsigned align, typename A>
-typename fifo<T,align,A>::size_type
-fifo<T,align,A>::discard(size_type num) {
+template <typename T, unsigned align, typename A, typename S>
+typename fifo<T,align,A,S>::size_type
+fifo<T,align,A,S>::discard(size_type num) {
   _read.reset_recent();
   num = std::min(num, space_used());
   auto xfer_size = std::min(num, next_read_wrap());
@@ -470,13 +503,14 @@ fifo<T,align,A>::discard(size_type num) {
     contiguous_discard(xfer_size);
     xfer_size = num - _read.recent();
   }
+  record_read(last_read_size());
   return last_read_size();
 }
 
-template <typename T, unsigned align, typename A>
+template <typename T, unsigned align, typename A, typename S>
 template <typename output_iterator>
 output_iterator
-fifo<T,align,A>::read(output_iterator dst, size_type num) {
+fifo<T,align,A,S>::read(output_iterator dst, size_type num) {
   _read.reset_recent();
   num = std::min(num, space_used());
   auto xfer_size = std::min(num, next_read_wrap());
@@ -484,13 +518,14 @@ fifo<T,align,A>::read(output_iterator dst, size_type num) {
     dst = contiguous_read(dst, xfer_size);
     xfer_size = num - _read.recent();
   }
+  record_read(last_read_size());
   return dst;
 }
 
-template <typename T, unsigned align, typename A>
+template <typename T, unsigned align, typename A, typename S>
 template <typename input_iterator>
 input_iterator
-fifo<T,align,A>::write(input_iterator src, size_type num) {
+fifo<T,align,A,S>::write(input_iterator src, size_type num) {
   _write.reset_recent();
   num = std::min(num, space_free());
   auto xfer_size = std::min(num, next_write_wrap());
@@ -498,6 +533,7 @@ fifo<T,align,A>::write(input_iterator src, size_type num) {
     src = contiguous_write(src, xfer_size);
     xfer_size = num - _write.recent();
   }
+  record_write(last_write_size());
   return src;
 }
 
@@ -0,0 +1,343 @@
+#ifndef ARR_FIFO_STATISTICS_HPP
+#define ARR_FIFO_STATISTICS_HPP
+//
+// Copyright (c) 2026
+// Kyle Markley.  All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+// 3. Neither the name of the author nor the names of any contributors may be
+//    used to endorse or promote products derived from this software without
+//    specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+namespace arr {
+
+///
+/// \ingroup buffers
+/// Aggregated occupancy and stall statistics of one or more fifos
+///
+/// Summaries of several fifos may be combined with \c operator+= to size a
+/// group of queues from their combined behavior.
+///
+/// Histograms have power-of-two buckets: bucket 0 counts the value 0, and
+/// bucket \c k counts values from 2^(k-1) up to 2^k - 1, except that the
+/// last bucket also counts every larger value.
+///
+struct fifo_statistics_summary {
+  using count_type = std::uint64_t;
+  using duration   = std::chrono::nanoseconds;
+  static constexpr std::size_t buckets = 32u;
+  using histogram  = std::array<count_type, buckets>;
+
+  /// Bucket of a histogram counting a value
+  static constexpr std::size_t bucket(count_type value) noexcept {
+    return std::min<std::size_t>(std::bit_width(value), buckets - 1u);
+  }
+
+  /// Smallest value counted by a bucket
+  static constexpr count_type bucket_floor(std::size_t k) noexcept {
+    return k ? count_type(1) << (k - 1u) : 0u;
+  }
+
+  count_type write_batches  = 0u; ///< Write operations transferring elements
+  count_type write_elements = 0u; ///< Elements written
+  count_type read_batches   = 0u; ///< Read operations transferring elements
+  count_type read_elements  = 0u; ///< Elements read or discarded
+  count_type high_water     = 0u; ///< Highest occupancy seen after a write
+  count_type writer_parks   = 0u; ///< Writer waits for a read (fifo full)
+  count_type reader_parks   = 0u; ///< Reader waits for a write (fifo empty)
+  count_type writer_wakes   = 0u; ///< Reads that found a parked writer
+  count_type reader_wakes   = 0u; ///< Writes that found a parked reader
+  duration   time_full  {0};      ///< Time spent full
+  duration   time_empty {0};      ///< Time spent empty
+  histogram  occupancy   {};      ///< Occupancy after each write
+  histogram  write_sizes {};      ///< Elements of each write operation
+  histogram  read_sizes  {};      ///< Elements of each read operation
+
+  /// Average number of elements per write operation
+  double average_write_batch() const noexcept {
+    return write_batches ? double(write_elements) / double(write_batches) : 0.0;
+  }
+
+  /// Average number of elements per read operation
+  double average_read_batch() const noexcept {
+    return read_batches ? double(read_elements) / double(read_batches) : 0.0;
+  }
+
+  /// Combine with the summary of another fifo
+  fifo_statistics_summary& operator+=(const fifo_statistics_summary& peer) {
+    write_batches  += peer.write_batches;
+    write_elements += peer.write_elements;
+    read_batches   += peer.read_batches;
+    read_elements  += peer.read_elements;
+    high_water      = std::max(high_water, peer.high_water);
+    writer_parks   += peer.writer_parks;
+    reader_parks   += peer.reader_parks;
+    writer_wakes   += peer.writer_wakes;
+    reader_wakes   += peer.reader_wakes;
+    time_full      += peer.time_full;
+    time_empty     += peer.time_empty;
+    for (std::size_t k = 0; k < buckets; ++k) {
+      occupancy  [k] += peer.occupancy  [k];
+      write_sizes[k] += peer.write_sizes[k];
+      read_sizes [k] += peer.read_sizes [k];
+    }
+    return *this;
+  }
+
+  ///
+  /// Visit each exported value
+  ///
+  /// @param visitor Called as \c visitor(name,value) for each value
+  ///
+  /// This is the extension point for exporting to a metrics system.  Each
+  /// non-empty histogram bucket is a value named for the histogram and the
+  /// bucket's smallest value, as in \c occupancy_from_4.
+  ///
+  template <typename F> void for_each(F&& visitor) const {
+    visitor("write_batches"      , double(write_batches));
+    visitor("write_elements"     , double(write_elements));
+    visitor("read_batches"       , double(read_batches));
+    visitor("read_elements"      , double(read_elements));
+    visitor("average_write_batch", average_write_batch());
+    visitor("average_read_batch" , average_read_batch());
+    visitor("high_water"         , double(high_water));
+    visitor("writer_parks"       , double(writer_parks));
+    visitor("reader_parks"       , double(reader_parks));
+    visitor("writer_wakes"       , double(writer_wakes));
+    visitor("reader_wakes"       , double(reader_wakes));
+    visitor("time_full_seconds"  , std::chrono::duration<double>(time_full).count());
+    visitor("time_empty_seconds" , std::chrono::duration<double>(time_empty).count());
+    std::string name;
+    auto buckets_of = [&](std::string_view histogram_name,
+        const histogram& h) {
+      for (std::size_t k = 0; k < buckets; ++k) {
+        if (not h[k]) continue;
+        name.assign(histogram_name);
+        name += "_from_";
+        name += std::to_string(bucket_floor(k));
+        visitor(std::string_view(name), double(h[k]));
+      }
+    };
+    buckets_of("occupancy"  , occupancy);
+    buckets_of("write_sizes", write_sizes);
+    buckets_of("read_sizes" , read_sizes);
+  }
+
+  ///
+  /// Export in a line-oriented "name value" text format
+  ///
+  /// @param o      Destination stream
+  /// @param prefix Prefix applied to every name
+  ///
+  std::ostream& export_text(std::ostream& o,
+      std::string_view prefix = "arr_fifo_") const {
+    for_each([&](std::string_view name, double value) {
+      o << prefix << name << ' ' << value << '\n';
+    });
+    return o;
+  }
+};
+
+inline std::ostream& operator<<(
+    std::ostream& o, const fifo_statistics_summary& s) {
+  return s.export_text(o);
+}
+
+///
+/// \ingroup buffers
+/// Occupancy and stall instrumentation for a fifo
+///
+/// The instrumentation is selected at compile time through a template
+/// parameter of \c fifo.  The default, \c fifo_statistics<false>, is an empty
+/// type and every call to it is discarded, so an uninstrumented fifo has no
+/// additional storage or run-time cost.
+///
+/// Counters are updated with relaxed atomic operations from the reader and
+/// writer threads.  They are intended for sizing and tuning, not for
+/// synchronization; in particular, wakes are inferred from waiter counts and
+/// the full/empty times are accumulated on state transitions, so concurrent
+/// transitions may be attributed slightly late.
+///
+template <bool enabled = false>
+struct fifo_statistics {
+  static constexpr bool is_enabled = false;
+  fifo_statistics_summary summary() const noexcept { return {}; }
+};
+
+template <>
+struct fifo_statistics<true> {
+  static constexpr bool is_enabled = true;
+  using count_type = fifo_statistics_summary::count_type;
+  using clock = std::chrono::steady_clock;
+  using enum std::memory_order;
+
+  fifo_statistics() noexcept { _empty_since.store(now(), relaxed); }
+
+  fifo_statistics(const fifo_statistics& ) = delete;
+  fifo_statistics& operator=(const fifo_statistics& ) = delete;
+
+  ///
+  /// Record a write operation, from the writer thread
+  ///
+  /// @param num      Number of elements written
+  /// @param used     Occupancy after the write
+  /// @param capacity Capacity of the fifo
+  /// @param waiting  Whether a reader was waiting for the write
+  ///
+  void wrote(count_type num, count_type used, count_type capacity,
+      bool waiting) noexcept {
+    if (not num) return;
+    bump(_write_batches);
+    bump(_write_elements, num);
+    bump(_occupancy[fifo_statistics_summary::bucket(used)]);
+    bump(_write_sizes[fifo_statistics_summary::bucket(num)]);
+    if (waiting) bump(_reader_wakes);
+    if (used > _high_water.load(relaxed)) _high_water.store(used, relaxed);
+    close_interval(_empty_since, _time_empty);
+    if (used == capacity) open_interval(_full_since);
+  }
+
+  ///
+  /// Record a read or discard operation, from the reader thread
+  ///
+  /// @param num      Number of elements read
+  /// @param used     Occupancy after the read
+  /// @param waiting  Whether a writer was waiting for the read
+  ///
+  void read(count_type num, count_type used, bool waiting) noexcept {
+    if (not num) return;
+    bump(_read_batches);
+    bump(_read_elements, num);
+    bump(_read_sizes[fifo_statistics_summary::bucket(num)]);
+    if (waiting) bump(_writer_wakes);
+    close_interval(_full_since, _time_full);
+    if (0u == used) open_interval(_empty_since);
+  }
+
+  /// Record the writer waiting for a read
+  void writer_parked() noexcept { bump(_writer_parks); }
+
+  /// Record the reader waiting for a write
+  void reader_parked() noexcept { bump(_reader_parks); }
+
+  ///
+  /// Snapshot of the statistics
+  ///
+  /// An interval of being full or empty that is still in progress is
+  /// included up to the present time.
+  ///
+  fifo_statistics_summary summary() const noexcept {
+    fifo_statistics_summary s;
+    s.write_batches  = _write_batches .load(relaxed);
+    s.write_elements = _write_elements.load(relaxed);
+    s.read_batches   = _read_batches  .load(relaxed);
+    s.read_elements  = _read_elements .load(relaxed);
+    s.high_water     = _high_water    .load(relaxed);
+    s.writer_parks   = _writer_parks  .load(relaxed);
+    s.reader_parks   = _reader_parks  .load(relaxed);
+    s.writer_wakes   = _writer_wakes  .load(relaxed);
+    s.reader_wakes   = _reader_wakes  .load(relaxed);
+    s.time_full  = std::chrono::nanoseconds(
+        _time_full .load(relaxed) + pending(_full_since));
+    s.time_empty = std::chrono::nanoseconds(
+        _time_empty.load(relaxed) + pending(_empty_since));
+    for (std::size_t k = 0; k < fifo_statistics_summary::buckets; ++k) {
+      s.occupancy  [k] = _occupancy  [k].load(relaxed);
+      s.write_sizes[k] = _write_sizes[k].load(relaxed);
+      s.read_sizes [k] = _read_sizes [k].load(relaxed);
+    }
+    return s;
+  }
+
+private:
+
+  using stamp_type = std::int64_t;
+  using histogram_type = std::array<std::atomic<count_type>,
+        fifo_statistics_summary::buckets>;
+
+  static stamp_type now() noexcept {
+    using namespace std::chrono;
+    auto t = duration_cast<nanoseconds>(clock::now().time_since_epoch());
+    return std::max<stamp_type>(t.count(), 1); // zero means "not in progress"
+  }
+
+  static void bump(std::atomic<count_type>& counter,
+      count_type amount = 1u) noexcept {
+    counter.store(counter.load(relaxed) + amount, relaxed);
+  }
+
+  static void open_interval(std::atomic<stamp_type>& since) noexcept {
+    stamp_type expected = 0;
+    since.compare_exchange_strong(expected, now(), acq_rel, relaxed);
+  }
+
+  static void close_interval(
+      std::atomic<stamp_type>& since,
+      std::atomic<stamp_type>& total) noexcept {
+    if (not since.load(relaxed)) return;
+    auto start = since.exchange(0, acq_rel);
+    if (start) total.fetch_add(now() - start, relaxed);
+  }
+
+  static stamp_type pending(const std::atomic<stamp_type>& since) noexcept {
+    auto start = since.load(relaxed);
+    return start ? now() - start : 0;
+  }
+
+  // Updated by the writer
+  alignas(64)
+  std::atomic<count_type> _write_batches  {0u};
+  std::atomic<count_type> _write_elements {0u};
+  std::atomic<count_type> _high_water     {0u};
+  std::atomic<count_type> _writer_parks   {0u};
+  std::atomic<count_type> _reader_wakes   {0u};
+  std::atomic<stamp_type> _time_empty     {0};
+  histogram_type _occupancy   = {};
+  histogram_type _write_sizes = {};
+  // Updated by the reader
+  alignas(64)
+  std::atomic<count_type> _read_batches   {0u};
+  std::atomic<count_type> _read_elements  {0u};
+  std::atomic<count_type> _reader_parks   {0u};
+  std::atomic<count_type> _writer_wakes   {0u};
+  std::atomic<stamp_type> _time_full      {0};
+  histogram_type _read_sizes  = {};
+  // Handed between the writer and the reader
+  alignas(64)
+  std::atomic<stamp_type> _full_since     {0};
+  std::atomic<stamp_type> _empty_since    {0};
+};
+
+}
+
+#endif
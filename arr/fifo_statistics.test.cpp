@@ -0,0 +1,185 @@
+//
+// Copyright (c) 2026
+// Kyle Markley.  All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+// 3. Neither the name of the author nor the names of any contributors may be
+//    used to endorse or promote products derived from this software without
+//    specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include "arrtest/arrtest.hpp"
+#include "arr/fifo.hpp"
+#include <array>
+#include <cmath>
+#include <sstream>
+#include <thread>
+#include <type_traits>
+
+UNIT_TEST_MAIN
+
+using namespace arr;
+using namespace std;
+
+using plain_fifo = fifo<int>;
+using stats_fifo = fifo<int, 64u, allocator<int>, fifo_statistics<true>>;
+
+SUITE(disabled) {
+
+  TEST(empty_policy) {
+    CHECK_EQUAL(true, is_empty_v<fifo_statistics<false>>);
+    CHECK_EQUAL(true, is_empty_v<plain_fifo::statistics>);
+  }
+
+  TEST(summary_is_zero) {
+    plain_fifo buf(4);
+    buf.push(1);
+    buf.pop();
+    auto s = buf.get_statistics().summary();
+    CHECK_EQUAL(0u, s.write_batches);
+    CHECK_EQUAL(0u, s.read_batches);
+  }
+
+}
+
+SUITE(enabled) {
+
+  array<int, 4> i = {{ 1, 2, 3, 4 }};
+  array<int, 4> o = {{ 0, 0, 0, 0 }};
+
+  TEST(batches) {
+    stats_fifo buf(4);
+    buf.write(i.data(), 3);
+    buf.write(i.data(), 3);     // Only one fits
+    buf.read(o.data(), 2);
+    buf.push(5);
+    buf.discard(3);
+    auto s = buf.get_statistics().summary();
+    CHECK_EQUAL(3u, s.write_batches);
+    CHECK_EQUAL(5u, s.write_elements);
+    CHECK_EQUAL(2u, s.read_batches);
+    CHECK_EQUAL(5u, s.read_elements);
+    CHECK_EQUAL(4u, s.high_water);
+    CHECK_EQUAL(true, abs(5.0/3.0 - s.average_write_batch()) < 1e-9);
+    CHECK_EQUAL(true, abs(2.5 - s.average_read_batch()) < 1e-9);
+    // Writes of 3, 1 and 1 elements, leaving 3, 4 and 3
+    CHECK_EQUAL(2u, s.write_sizes[1]);
+    CHECK_EQUAL(1u, s.write_sizes[2]);
+    CHECK_EQUAL(2u, s.occupancy[2]);
+    CHECK_EQUAL(1u, s.occupancy[3]);
+    // Reads of 2 and 3 elements
+    CHECK_EQUAL(2u, s.read_sizes[2]);
+  }
+
+  TEST(empty_transfers_ignored) {
+    stats_fifo buf(2);
+    buf.read(o.data(), 2);
+    buf.write(i.data(), 0);
+    auto s = buf.get_statistics().summary();
+    CHECK_EQUAL(0u, s.write_batches);
+    CHECK_EQUAL(0u, s.read_batches);
+  }
+
+  TEST(time_full) {
+    stats_fifo buf(2);
+    buf.write(i.data(), 2);
+    this_thread::sleep_for(2ms);
+    auto during = buf.get_statistics().summary();
+    CHECK_EQUAL(true, during.time_full >= 2ms);
+    buf.pop();
+    this_thread::sleep_for(2ms);
+    auto after = buf.get_statistics().summary();
+    CHECK_EQUAL(true, after.time_full >= 2ms);
+    auto later = buf.get_statistics().summary();
+    CHECK_EQUAL(true, later.time_full == after.time_full);
+  }
+
+  TEST(time_empty) {
+    stats_fifo buf(2);
+    this_thread::sleep_for(2ms);
+    buf.push(1);
+    auto s = buf.get_statistics().summary();
+    CHECK_EQUAL(true, s.time_empty >= 2ms);
+    auto t = buf.get_statistics().summary();
+    CHECK_EQUAL(true, s.time_empty == t.time_empty);
+  }
+
+  TEST(parks) {
+    stats_fifo buf(1);
+    thread reader([&] {
+      buf.wait_for_write();
+      buf.pop();
+    });
+    while (0u == buf.get_statistics().summary().reader_parks) {
+      this_thread::yield();
+    }
+    buf.push(1);
+    reader.join();
+    auto s = buf.get_statistics().summary();
+    CHECK_EQUAL(1u, s.reader_parks);
+    CHECK_EQUAL(0u, s.writer_parks);
+    CHECK_EQUAL(true, s.reader_wakes <= 1u);
+  }
+
+}
+
+SUITE(exporting) {
+
+  TEST(buckets) {
+    CHECK_EQUAL(0u, fifo_statistics_summary::bucket(0u));
+    CHECK_EQUAL(1u, fifo_statistics_summary::bucket(1u));
+    CHECK_EQUAL(2u, fifo_statistics_summary::bucket(3u));
+    CHECK_EQUAL(3u, fifo_statistics_summary::bucket(4u));
+    CHECK_EQUAL(31u, fifo_statistics_summary::bucket(~0ull));
+    CHECK_EQUAL(0u, fifo_statistics_summary::bucket_floor(0u));
+    CHECK_EQUAL(4u, fifo_statistics_summary::bucket_floor(3u));
+  }
+
+  TEST(aggregate) {
+    fifo_statistics_summary a, b;
+    a.write_batches = 1u;
+    a.high_water = 7u;
+    b.write_batches = 2u;
+    b.high_water = 3u;
+    a.occupancy[2] = 1u;
+    b.occupancy[2] = 4u;
+    a += b;
+    CHECK_EQUAL(5u, a.occupancy[2]);
+    CHECK_EQUAL(3u, a.write_batches);
+    CHECK_EQUAL(7u, a.high_water);
+  }
+
+  TEST(text) {
+    fifo_statistics_summary s;
+    s.write_batches = 2u;
+    s.write_elements = 6u;
+    ostringstream o;
+    s.write_sizes[fifo_statistics_summary::bucket(3u)] = 2u;
+    s.export_text(o, "q_");
+    auto text = o.str();
+    CHECK_EQUAL(true, string::npos != text.find("q_write_batches 2\n"));
+    CHECK_EQUAL(true, string::npos != text.find("q_average_write_batch 3\n"));
+    CHECK_EQUAL(true, string::npos != text.find("q_write_sizes_from_2 2\n"));
+    CHECK_EQUAL(string::npos, text.find("q_occupancy_from_"));
+  }
+
+}
@@ -1,5 +1,5 @@
 //
-// Copyright (c) 2012, 2014, 2021
+// Copyright (c) 2012, 2014, 2021, 2026
 // Kyle Markley.  All rights reserved.
 //
 // Redistribution and use in source and binary forms, with or without
@@ -29,6 +29,7 @@
 
 #include "arr/glob.hpp"
 #include "arr/syscall_exception.hpp"
+#include <cstring>
 
 namespace wrap {
 
@@ -54,4 +55,36 @@ std::list<std::string> glob(
   return result;
 }
 
+void glob(
+    arr::source_context context,
+    const char *pattern,
+    arr::string_arena& result,
+    int flags,
+    int (*errfunc)(const char *, int)) {
+  glob_t matches;
+  auto r = ::glob(pattern, flags, errfunc, &matches);
+  if (GLOB_NOMATCH == r) {
+    return;
+  } else if (0 != r) {
+    throw arr::syscall_exception(context, __func__);
+  }
+  std::size_t characters = 0;
+  for (decltype(matches.gl_pathc) i=0; i<matches.gl_pathc; ++i) {
+    characters += std::strlen(matches.gl_pathv[i]) + 1u;
+  }
+  try {
+    result.reserve(result.size() + matches.gl_pathc,
+        result.characters() + characters);
+    for (decltype(matches.gl_pathc) i=0; i<matches.gl_pathc; ++i) {
+      result.push_back(matches.gl_pathv[i]);
+    }
+  } catch (...) {
+    ::globfree(&matches);
+    throw;
+  }
+  errno = 0;
+  ::globfree(&matches);
+  if (errno) throw arr::syscall_exception(context, "globfree");
+}
+
 }
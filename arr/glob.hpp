@@ -1,7 +1,7 @@
 #ifndef WRAP_GLOB_HPP
 #define WRAP_GLOB_HPP
 //
-// Copyright (c) 2012, 2021
+// Copyright (c) 2012, 2021, 2026
 // Kyle Markley.  All rights reserved.
 //
 // Redistribution and use in source and binary forms, with or without
@@ -30,6 +30,7 @@
 //
 
 #include "arr/source_context.hpp"
+#include "arr/string_arena.hpp"
 #include <glob.h>
 #include <string>
 #include <list>
@@ -70,6 +71,22 @@ std::list<std::string> glob(
     int flags = GLOB_NOSORT|GLOB_BRACE|GLOB_TILDE,
     int (*errfunc)(const char *, int) = nullptr);
 
+///
+/// Wrapper for glob(3), appending to a compact result
+///
+/// This is as above, except that the matches are appended to \c result,
+/// which holds them in one contiguous arena rather than one allocation per
+/// match.  Storage for all of the matches is reserved at once.  The arena
+/// may be sorted afterward with \c string_arena::sort if GLOB_NOSORT is
+/// given.
+///
+void glob(
+    arr::source_context,
+    const char *pattern,
+    arr::string_arena& result,
+    int flags = GLOB_NOSORT|GLOB_BRACE|GLOB_TILDE,
+    int (*errfunc)(const char *, int) = nullptr);
+
 /// @}
 
 }
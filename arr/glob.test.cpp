@@ -1,5 +1,5 @@
 //
-// Copyright (c) 2012, 2013, 2016, 2021
+// Copyright (c) 2012, 2013, 2016, 2021, 2026
 // Kyle Markley.  All rights reserved.
 //
 // Redistribution and use in source and binary forms, with or without
@@ -71,4 +71,21 @@ SUITE(all) {
     CHECK_EQUAL(0u, results.size());
   }
 
+  TEST(arena) {
+    temp_dir d;
+    create_file(d.name(), "/bb");
+    create_file(d.name(), "/aa");
+    create_file(d.name(), "/ba");
+    string glob = d.name() + string("/{b,a}*");
+    arr::string_arena results;
+    wrap::glob(SOURCE_CONTEXT, glob.c_str(), results);
+    CHECK_EQUAL(3u, results.size());
+    results.sort();
+    CHECK_EQUAL(d.name() + string("/aa"), string(results[0]));
+    CHECK_EQUAL(d.name() + string("/bb"), string(results[2]));
+    string none = d.name() + string("/*x");
+    wrap::glob(SOURCE_CONTEXT, none.c_str(), results);
+    CHECK_EQUAL(3u, results.size());
+  }
+
 }
@@ -0,0 +1,319 @@
+//
+// Copyright (c) 2026
+// Kyle Markley.  All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+// 3. Neither the name of the author nor the names of any contributors may be
+//    used to endorse or promote products derived from this software without
+//    specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include "arr/glob_sequence.hpp"
+#include "arr/parallel_directory_traversal.hpp"
+#include "arr/path_match.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <pwd.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace arr {
+
+namespace {
+
+constexpr char separator = '/';
+constexpr std::string_view globstar = "**";
+
+bool is_wild(std::string_view component) noexcept {
+  return std::string_view::npos != component.find_first_of("*?[\\");
+}
+
+/// Divide a relative path into its components
+void split(std::string_view path, std::vector<std::string_view>& names) {
+  names.clear();
+  while (not path.empty()) {
+    auto end = path.find(separator);
+    if (std::string_view::npos == end) end = path.size();
+    if (end) names.push_back(path.substr(0, end));
+    path.remove_prefix(std::min(end + 1u, path.size()));
+  }
+}
+
+/// Whether a name matches a component, where a wildcard skips a leading '.'
+bool component_match(std::string_view pattern, std::string_view name) {
+  if ('.' == name.front() and '.' != pattern.front()) return false;
+  return path_match(pattern, name);
+}
+
+///
+/// Whether names from \c j on match components from \c i on
+///
+/// With \c below, whether a path below the names could match instead.
+///
+bool match_from(const std::vector<std::string>& components, std::size_t i,
+    const std::vector<std::string_view>& names, std::size_t j, bool below) {
+  if (j == names.size()) {
+    if (below) return i < components.size();
+    while (i < components.size() and globstar == components[i]) ++i;
+    return i == components.size();
+  }
+  if (i == components.size()) return false;
+  if (globstar == components[i]) {
+    if (match_from(components, i + 1u, names, j, below)) return true;
+    return '.' != names[j].front() and
+      match_from(components, i, names, j + 1u, below);
+  }
+  return component_match(components[i], names[j]) and
+    match_from(components, i + 1u, names, j + 1u, below);
+}
+
+bool is_directory(const std::string& path) noexcept {
+  struct stat sb;
+  return 0 == ::stat(path.c_str(), &sb) and S_ISDIR(sb.st_mode);
+}
+
+bool exists(const std::string& path) noexcept {
+  struct stat sb;
+  return 0 == ::lstat(path.c_str(), &sb);
+}
+
+std::string traversal_root(const std::string& prefix) {
+  return prefix.empty() ? std::string(".") : prefix;
+}
+
+std::size_t root_length(const std::string& prefix) noexcept {
+  return prefix.empty() ? 2u : prefix.size();
+}
+
+}
+
+std::vector<std::string> expand_braces(std::string_view pattern) {
+  //
+  // Find the first brace with a matching close brace, and the top-level
+  // commas within it.
+  //
+  std::size_t open = std::string_view::npos;
+  std::vector<std::size_t> commas;
+  unsigned depth = 0u;
+  for (std::size_t i = 0; i < pattern.size(); ++i) {
+    auto c = pattern[i];
+    if ('\\' == c) {
+      ++i;
+    } else if ('{' == c) {
+      if (0u == depth++) {
+        open = i;
+        commas.clear();
+      }
+    } else if ('}' == c and depth) {
+      if (0u == --depth) {
+        if (i == open + 1u) continue;   // {} is literal
+        std::vector<std::string> result;
+        auto prefix = pattern.substr(0, open);
+        auto suffix = pattern.substr(i + 1u);
+        commas.push_back(i);
+        auto start = open + 1u;
+        for (auto end : commas) {
+          std::string alternative(prefix);
+          alternative += pattern.substr(start, end - start);
+          alternative += suffix;
+          for (auto& expanded : expand_braces(alternative)) {
+            result.push_back(std::move(expanded));
+          }
+          start = end + 1u;
+        }
+        return result;
+      }
+    } else if (',' == c and 1u == depth) {
+      commas.push_back(i);
+    }
+  }
+  if (depth) {
+    //
+    // The first open brace is unmatched, so it is literal, but braces
+    // after it may still be expanded.
+    //
+    std::vector<std::string> result;
+    for (auto& rest : expand_braces(pattern.substr(open + 1u))) {
+      result.emplace_back(pattern.substr(0, open + 1u));
+      result.back() += rest;
+    }
+    return result;
+  }
+  return {std::string(pattern)};
+}
+
+std::string expand_tilde(std::string_view pattern) {
+  if (pattern.empty() or '~' != pattern.front()) return std::string(pattern);
+  auto end = std::min(pattern.find(separator), pattern.size());
+  auto user = std::string(pattern.substr(1u, end - 1u));
+  const char * home = nullptr;
+  if (user.empty()) {
+    home = std::getenv("HOME");
+    if (not home) {
+      auto pw = ::getpwuid(::getuid());
+      if (pw) home = pw->pw_dir;
+    }
+  } else {
+    auto pw = ::getpwnam(user.c_str());
+    if (pw) home = pw->pw_dir;
+  }
+  if (not home) return std::string(pattern);
+  return home + std::string(pattern.substr(end));
+}
+
+glob_iterator::glob_iterator(glob_sequence * gs)
+  : container(gs)
+{
+  if (container and not container->advance()) container = nullptr;
+}
+
+glob_iterator& glob_iterator::operator++() {
+  if (not container->advance()) container = nullptr;
+  return *this;
+}
+
+glob_iterator::reference glob_iterator::operator*() const noexcept {
+  return container->_match;
+}
+
+glob_sequence::glob_sequence(std::string_view pattern)
+{
+  for (auto& expanded : expand_braces(pattern)) {
+    _patterns.push_back(expand_tilde(expanded));
+    auto& text = _patterns.back();
+    compiled_pattern p;
+    p.directories_only = text.size() > 1u and separator == text.back();
+    if (not text.empty() and separator == text.front()) p.prefix += separator;
+    std::vector<std::string_view> names;
+    split(text, names);
+    bool literal = true;
+    for (auto name : names) {
+      literal = literal and not is_wild(name);
+      if (literal) {
+        p.prefix += name;
+        p.prefix += separator;
+      } else {
+        p.components.emplace_back(name);
+      }
+    }
+    _compiled.push_back(std::move(p));
+  }
+}
+
+glob_sequence::~glob_sequence() = default;
+
+glob_iterator glob_sequence::begin() {
+  _index = 0u;
+  _traversal.reset();
+  return glob_iterator(this);
+}
+
+bool glob_sequence::advance() {
+  while (_index < _compiled.size()) {
+    auto& p = _compiled[_index];
+    if (not _traversal) {
+      if (p.components.empty()) {
+        //
+        // With no wildcard, the pattern matches only itself.
+        //
+        auto& text = _patterns[_index++];
+        if (p.directories_only ? is_directory(text) : exists(text)) {
+          _match = text;
+          return true;
+        }
+        continue;
+      }
+      auto root = traversal_root(p.prefix);
+      if (not is_directory(root)) {
+        ++_index;
+        continue;
+      }
+      _root_length = root_length(p.prefix);
+      _traversal = std::make_unique<recursive_directory_sequence>(root);
+      _position = _traversal->begin();
+    } else {
+      ++_position;
+    }
+    for (; _position != _traversal->end(); ++_position) {
+      auto relative = _traversal->full_path().substr(_root_length);
+      split(relative, _names);
+      bool directory = DT_DIR == _position->d_type;
+      if (directory and not match_from(p.components, 0u, _names, 0u, true)) {
+        _traversal->abandon();
+      }
+      if ((directory or not p.directories_only) and
+          match_from(p.components, 0u, _names, 0u, false)) {
+        _match.assign(p.prefix).append(relative);
+        if (p.directories_only) _match += separator;
+        return true;
+      }
+    }
+    exceptions.splice(exceptions.end(), _traversal->exceptions);
+    _traversal.reset();
+    ++_index;
+  }
+  return false;
+}
+
+void glob_sequence::for_each(const visitor_type& visitor, unsigned threads) {
+  for (std::size_t index = 0; index < _compiled.size(); ++index) {
+    auto& p = _compiled[index];
+    auto& text = _patterns[index];
+    if (p.components.empty()) {
+      if (p.directories_only ? is_directory(text) : exists(text)) {
+        visitor(text);
+      }
+      continue;
+    }
+    auto root = traversal_root(p.prefix);
+    if (not is_directory(root)) continue;
+    auto skip = root_length(p.prefix);
+    parallel_directory_traversal pdt(root, threads);
+    //
+    // Each worker composes paths in its own buffers.
+    //
+    struct buffers {
+      std::string path;
+      std::vector<std::string_view> names;
+    };
+    std::vector<buffers> workers(pdt.threads());
+    pdt.run([&](const parallel_directory_entry& e) {
+      auto& [path, names] = workers[e.worker];
+      path.assign(p.prefix);
+      path.append(e.directory.path(), skip);
+      path.append(e.entry.d_name);
+      split(std::string_view(path).substr(p.prefix.size()), names);
+      bool directory = DT_DIR == e.entry.d_type;
+      if (directory) {
+        e.descend = match_from(p.components, 0u, names, 0u, true);
+      }
+      if ((directory or not p.directories_only) and
+          match_from(p.components, 0u, names, 0u, false)) {
+        if (p.directories_only) path += separator;
+        visitor(path);
+      }
+    });
+    exceptions.splice(exceptions.end(), pdt.exceptions);
+  }
+}
+
+}
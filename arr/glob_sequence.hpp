@@ -0,0 +1,180 @@
+#ifndef ARR_GLOB_SEQUENCE_HPP
+#define ARR_GLOB_SEQUENCE_HPP
+//
+// Copyright (c) 2026
+// Kyle Markley.  All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+// 3. Neither the name of the author nor the names of any contributors may be
+//    used to endorse or promote products derived from this software without
+//    specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include "arr/recursive_directory_sequence.hpp"
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace arr {
+
+struct glob_sequence;
+
+/// \addtogroup directory_traversal
+/// @{
+
+///
+/// Expand braces in a glob pattern
+///
+/// @param pattern Glob pattern
+/// @return The patterns it denotes, in order
+///
+/// As with \c GLOB_BRACE, each \c {a,b} is replaced by each of its
+/// comma-separated alternatives, which may themselves contain braces.  A
+/// brace without a matching close brace, and \c {}, are literal.  A
+/// backslash quotes the following character.
+///
+std::vector<std::string> expand_braces(std::string_view pattern);
+
+///
+/// Expand a leading tilde in a glob pattern
+///
+/// @param pattern Glob pattern
+/// @return The pattern with a leading \c ~ or \c ~user replaced
+///
+/// As with \c GLOB_TILDE, \c ~ is the home directory of the user, taken
+/// from \c HOME if it is set, and \c ~user is the home directory of that
+/// user.  A pattern naming an unknown user is returned unchanged.
+///
+std::string expand_tilde(std::string_view pattern);
+
+///
+/// Iterator for the sequence of paths matching a glob pattern
+///
+struct glob_iterator {
+  using iterator_category = std::input_iterator_tag;
+  using difference_type   = std::ptrdiff_t;
+  using value_type        = const std::string;
+  using pointer           = const std::string*;
+  using reference         = const std::string&;
+
+  glob_iterator() noexcept { }
+  glob_iterator(glob_sequence * gs);
+  friend bool operator==(const glob_iterator& a, const glob_iterator& b) {
+    return a.container == b.container;
+  }
+  friend bool operator!=(const glob_iterator& a, const glob_iterator& b) {
+    return !(a==b);
+  }
+  glob_iterator& operator++();
+  reference operator* () const noexcept;
+  pointer   operator->() const noexcept { return &**this; }
+private:
+  glob_sequence * container = nullptr;
+};
+
+///
+/// Paths matching a glob pattern, produced as they are found
+///
+/// Unlike \c wrap::glob, which has glob(3) find every match before any is
+/// returned, the directory tree is traversed as the iterator is advanced,
+/// and each match is composed in a buffer that is reused for the next.
+///
+/// The pattern syntax is that of \c path_match, with braces and a leading
+/// tilde expanded first.  A trailing '/' matches only directories.  As with
+/// glob(3), a wildcard does not match a leading '.' of a name, and paths
+/// are produced as the pattern spells them.  Unlike glob(3), the order is
+/// that of the directory traversal, not sorted.
+///
+/// The leading components of each pattern that contain no wildcard are the
+/// root of a traversal, so no other part of the filesystem is read, and a
+/// directory is only descended into if some path below it could match.
+/// Only \c ** descends through any number of directories.  Symbolic links
+/// to directories are not descended into, except where named by the
+/// leading components.
+///
+struct glob_sequence {
+  using visitor_type = std::function<void(std::string_view)>;
+
+  explicit glob_sequence(std::string_view pattern);
+  glob_sequence(const glob_sequence& ) = delete;
+  glob_sequence& operator=(const glob_sequence& ) = delete;
+  ~glob_sequence();
+
+  glob_iterator begin();
+  glob_iterator end() const noexcept { return glob_iterator(); }
+
+  ///
+  /// Visit every match using several threads
+  ///
+  /// @param visitor Called as \c visitor(path) for each match
+  /// @param threads Number of worker threads (0 for the number of CPUs)
+  ///
+  /// The visitor is called concurrently, as for
+  /// \c parallel_directory_traversal, and the path is valid only during the
+  /// call.  There is no ordering between matches.
+  ///
+  void for_each(const visitor_type& visitor, unsigned threads = 0u);
+
+  /// Patterns after expanding braces and tilde
+  const std::vector<std::string>& patterns() const noexcept {
+    return _patterns;
+  }
+
+  ///
+  /// Exceptions encountered during directory traversal
+  ///
+  /// Directories that cannot be read contribute no matches.
+  ///
+  std::list<std::unique_ptr<syscall_exception>> exceptions;
+
+private:
+  friend glob_iterator;
+
+  /// Pattern divided into the root of its traversal and the rest
+  struct compiled_pattern {
+    std::string prefix;         ///< Leading literal components, with '/'
+    std::vector<std::string> components;        ///< Remaining components
+    bool directories_only = false;              ///< Pattern ends with '/'
+  };
+
+  bool advance();
+
+  std::vector<std::string> _patterns;
+  std::vector<compiled_pattern> _compiled;
+  std::size_t _index = 0u;      ///< Pattern being traversed
+  std::unique_ptr<recursive_directory_sequence> _traversal;
+  recursive_directory_iterator _position;
+  std::size_t _root_length = 0u;        ///< Of paths from \c _traversal
+  std::string _match;                   ///< Current match
+  std::vector<std::string_view> _names; ///< Components being matched
+};
+
+/// @}
+
+}
+
+#endif
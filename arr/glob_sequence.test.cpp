@@ -0,0 +1,209 @@
+//
+// Copyright (c) 2026
+// Kyle Markley.  All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+// 3. Neither the name of the author nor the names of any contributors may be
+//    used to endorse or promote products derived from this software without
+//    specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include "arrtest/arrtest.hpp"
+#include "arr/glob_sequence.hpp"
+#include "arr/fcntl.hpp"
+#include "arr/file_descriptor.hpp"
+#include "arr/temp_dir.hpp"
+#include "arr/unistd.hpp"
+#include <cstdlib>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+UNIT_TEST_MAIN
+
+using namespace arr;
+using namespace std;
+
+namespace {
+
+void touch(const string& path) {
+  wrap::file_descriptor fd = wrap::open(SOURCE_CONTEXT,
+      path.c_str(), O_WRONLY|O_CREAT, 0600);
+}
+
+// Root with a.cpp, b.h, .hidden.cpp, src/c.cpp, src/d.h, src/deep/e.cpp,
+// lib/f.cpp, and .git/g.cpp
+struct tree {
+  tree() : root(string(dir.name()) + "/") {
+    for (auto d : { "src", "src/deep", "lib", ".git" }) {
+      wrap::mkdir(SOURCE_CONTEXT, (root + d).c_str(), 0700);
+    }
+    for (auto f : { "a.cpp", "b.h", ".hidden.cpp", "src/c.cpp", "src/d.h",
+        "src/deep/e.cpp", "lib/f.cpp", ".git/g.cpp" }) {
+      touch(root + f);
+    }
+  }
+  set<string> glob(const string& pattern) {
+    glob_sequence gs(root + pattern);
+    set<string> result;
+    for (auto& path : gs) result.insert(path.substr(root.size()));
+    CHECK_EQUAL(0u, gs.exceptions.size());
+    return result;
+  }
+  set<string> parallel_glob(const string& pattern) {
+    glob_sequence gs(root + pattern);
+    set<string> result;
+    mutex lock;
+    gs.for_each([&](string_view path) {
+      lock_guard<mutex> hold(lock);
+      result.emplace(path.substr(root.size()));
+    }, 4u);
+    CHECK_EQUAL(0u, gs.exceptions.size());
+    return result;
+  }
+  temp_dir dir;
+  string root;
+};
+
+}
+
+SUITE(expansion) {
+
+  TEST(braces) {
+    CHECK_EQUAL(true, (expand_braces("a{b,c}d") ==
+          vector<string>{"abd", "acd"}));
+    CHECK_EQUAL(true, (expand_braces("{a,b{c,d}}") ==
+          vector<string>{"a", "bc", "bd"}));
+    CHECK_EQUAL(true, (expand_braces("{a,b}{c,d}") ==
+          vector<string>{"ac", "ad", "bc", "bd"}));
+    CHECK_EQUAL(true, (expand_braces("{a,}") == vector<string>{"a", ""}));
+  }
+
+  TEST(literal_braces) {
+    CHECK_EQUAL(true, (expand_braces("a{}b") == vector<string>{"a{}b"}));
+    CHECK_EQUAL(true, (expand_braces("a{b") == vector<string>{"a{b"}));
+    CHECK_EQUAL(true, (expand_braces("\\{a,b}") ==
+          vector<string>{"\\{a,b}"}));
+    CHECK_EQUAL(true, (expand_braces("{x{a,b}") ==
+          vector<string>{"{xa", "{xb"}));
+  }
+
+  TEST(tilde) {
+    auto saved = getenv("HOME");
+    string home = saved ? saved : "";
+    setenv("HOME", "/home/somebody", 1);
+    CHECK_EQUAL("/home/somebody/*.cpp", expand_tilde("~/*.cpp"));
+    CHECK_EQUAL("/home/somebody", expand_tilde("~"));
+    CHECK_EQUAL("a/~", expand_tilde("a/~"));
+    CHECK_EQUAL("~no_such_user_here/x", expand_tilde("~no_such_user_here/x"));
+    if (saved) setenv("HOME", home.c_str(), 1); else unsetenv("HOME");
+  }
+
+}
+
+SUITE(matching) {
+
+  TEST(wildcards) {
+    tree t;
+    CHECK_EQUAL(true, (t.glob("*.cpp") == set<string>{"a.cpp"}));
+    CHECK_EQUAL(true, (t.glob("?.*") == set<string>{"a.cpp", "b.h"}));
+    CHECK_EQUAL(true, (t.glob("src/*") ==
+          set<string>{"src/c.cpp", "src/d.h", "src/deep"}));
+    CHECK_EQUAL(true, (t.glob("*/*.cpp") ==
+          set<string>{"src/c.cpp", "lib/f.cpp"}));
+    CHECK_EQUAL(true, (t.glob("*.x") == set<string>{}));
+  }
+
+  TEST(globstar) {
+    tree t;
+    CHECK_EQUAL(true, (t.glob("**/*.cpp") == set<string>{
+          "a.cpp", "src/c.cpp", "src/deep/e.cpp", "lib/f.cpp"}));
+    CHECK_EQUAL(true, (t.glob("src/**/*.cpp") ==
+          set<string>{"src/c.cpp", "src/deep/e.cpp"}));
+    CHECK_EQUAL(true, (t.glob("**/deep/*") ==
+          set<string>{"src/deep/e.cpp"}));
+  }
+
+  TEST(hidden) {
+    tree t;
+    CHECK_EQUAL(true, (t.glob(".*.cpp") == set<string>{".hidden.cpp"}));
+    CHECK_EQUAL(true, (t.glob(".git/*") == set<string>{".git/g.cpp"}));
+    CHECK_EQUAL(true, (t.glob("*/g.cpp") == set<string>{}));
+  }
+
+  TEST(braces) {
+    tree t;
+    CHECK_EQUAL(true, (t.glob("{src,lib}/*.cpp") ==
+          set<string>{"src/c.cpp", "lib/f.cpp"}));
+    CHECK_EQUAL(true, (t.glob("*.{cpp,h}") == set<string>{"a.cpp", "b.h"}));
+  }
+
+  TEST(directories) {
+    tree t;
+    CHECK_EQUAL(true, (t.glob("*/") == set<string>{"src/", "lib/"}));
+    CHECK_EQUAL(true, (t.glob("src/") == set<string>{"src/"}));
+    CHECK_EQUAL(true, (t.glob("a.cpp/") == set<string>{}));
+  }
+
+  TEST(literal) {
+    tree t;
+    CHECK_EQUAL(true, (t.glob("src/c.cpp") == set<string>{"src/c.cpp"}));
+    CHECK_EQUAL(true, (t.glob("src/x.cpp") == set<string>{}));
+    CHECK_EQUAL(true, (t.glob("missing/*.cpp") == set<string>{}));
+  }
+
+  TEST(relative) {
+    tree t;
+    vector<char> saved(4096);
+    CHECK_EQUAL(true, nullptr != ::getcwd(saved.data(), saved.size()));
+    wrap::chdir(SOURCE_CONTEXT, t.root.c_str());
+    set<string> result;
+    glob_sequence gs("*/*.cpp");
+    for (auto& path : gs) result.insert(path);
+    wrap::chdir(SOURCE_CONTEXT, saved.data());
+    CHECK_EQUAL(true, (result == set<string>{"src/c.cpp", "lib/f.cpp"}));
+  }
+
+  TEST(lazy) {
+    tree t;
+    glob_sequence gs(t.root + "**");
+    auto i = gs.begin();
+    CHECK_EQUAL(true, i != gs.end());
+    string first = *i;
+    CHECK_EQUAL(0, first.compare(0, t.root.size(), t.root));
+  }
+
+}
+
+SUITE(parallel) {
+
+  TEST(same_matches) {
+    tree t;
+    for (auto pattern : { "**/*.cpp", "*/", "src/**", "{src,lib}/*.cpp",
+        "a.cpp", "*.x" }) {
+      CHECK_EQUAL(true, (t.glob(pattern) == t.parallel_glob(pattern)));
+    }
+  }
+
+}
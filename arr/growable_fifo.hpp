@@ -0,0 +1,354 @@
+#ifndef ARR_GROWABLE_FIFO_HPP
+#define ARR_GROWABLE_FIFO_HPP
+//
+// Copyright (c) 2026
+// Kyle Markley.  All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+// 3. Neither the name of the author nor the names of any contributors may be
+//    used to endorse or promote products derived from this software without
+//    specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include "arr/fifo.hpp"
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <memory>
+
+namespace arr {
+
+///
+/// \ingroup buffers
+/// First-In First-Out buffer that grows and shrinks with demand
+///
+/// Elements are held in a chain of \c fifo segments.  When the writer finds
+/// its segment full, it links a new segment twice as large (up to a maximum)
+/// and continues writing there.  The reader drains each segment in turn, and
+/// frees it after moving on to the next.  Each segment is only written by the
+/// writer before it links the next one, so neither side ever waits for the
+/// other to resize, and no element is moved.
+///
+/// Optionally, after sustained low occupancy the writer links a segment half
+/// as large as its current one (down to the initial size), so that memory
+/// taken for a burst is returned once the reader catches up.
+///
+/// \par Concurrency
+///
+/// As with \c fifo, one reader thread and one writer thread may operate
+/// concurrently.
+///
+template <typename T, unsigned align = 64u,
+         typename A = std::allocator<T>>
+struct growable_fifo {
+  using value_type = T;
+  using allocator_type = A;
+  using segment_type = fifo<T,align,A>;
+  using size_type = typename segment_type::size_type;
+  using       reference =       value_type&;
+  using direction_data = buffer_direction<size_type>;
+
+  ///
+  /// Sizing of segments
+  ///
+  struct growth_policy {
+    size_type initial = 64u;    ///< Capacity of the first segment
+    size_type maximum = std::numeric_limits<size_type>::max();
+                                ///< Largest segment capacity
+    size_type shrink_after = 0u;
+                                ///< Consecutive writes at or below a quarter
+                                ///< of the current capacity before shrinking
+                                ///< (zero to never shrink)
+  };
+
+  ///
+  /// Construct a growable_fifo
+  ///
+  /// @param sizing Sizing of segments
+  /// @param policy Wake policy for waiting threads
+  /// @param alloc  Allocator to use for elements
+  ///
+  explicit growable_fifo(
+      growth_policy sizing,
+      wake_policy policy = wake_policy::all,
+      const allocator_type& alloc = allocator_type())
+    : _sizing(sizing)
+    , _policy(policy)
+    , _allocator(alloc)
+    , _head(make_segment(std::max<size_type>(1u, sizing.initial)))
+    , _tail(_head)
+  {
+    _sizing.initial = _tail->data.capacity();
+    _sizing.maximum = std::max(_sizing.maximum, _sizing.initial);
+  }
+
+  ~growable_fifo() {
+    while (_head) {
+      auto next = _head->next.load(std::memory_order::relaxed);
+      destroy_segment(_head);
+      _head = next;
+    }
+  }
+
+  growable_fifo(const growable_fifo& ) = delete;
+  growable_fifo(      growable_fifo&&) = delete;
+  growable_fifo& operator=(const growable_fifo& ) = delete;
+  growable_fifo& operator=(      growable_fifo&&) = delete;
+
+  allocator_type get_allocator() const { return _allocator; }
+
+  auto  read_total() const noexcept { return  _read.total(); }
+  auto write_total() const noexcept { return _write.total(); }
+
+  void wait_for_write(size_type old,
+      std::memory_order order = std::memory_order::seq_cst) noexcept {
+    _write.wait(old, order);
+  }
+  void wait_for_write(
+      std::memory_order order = std::memory_order::seq_cst) noexcept {
+    _write.wait(read_total(), order);
+  }
+
+  ///
+  /// Wait for the reader to read, as the writer
+  ///
+  /// @param old Value of \c read_total observed before finding the fifo full
+  /// @param order Memory order of the wait
+  ///
+  /// Unlike \c fifo, a full growable_fifo may hold more than \c capacity
+  /// elements, so the writer must supply the read total it observed.
+  ///
+  void wait_for_read(size_type old,
+      std::memory_order order = std::memory_order::seq_cst) noexcept {
+    _read.wait(old, order);
+  }
+
+  ///
+  /// @name Capacity
+  /// @{
+  ///
+  bool      empty() const noexcept { return size() == 0; }
+  /// Whether the fifo is at its maximum capacity and full, as the writer
+  bool       full() const noexcept {
+    return _tail->data.full() and _tail->data.capacity() == _sizing.maximum;
+  }
+  size_type  size() const noexcept { return write_total() - read_total(); }
+  /// Capacity of the segment being written, as the writer
+  size_type capacity() const noexcept { return _tail->data.capacity(); }
+  size_type initial_capacity() const noexcept { return _sizing.initial; }
+  size_type maximum_capacity() const noexcept { return _sizing.maximum; }
+  /// @}
+
+  ///
+  /// @name Element access
+  /// @{
+  ///
+  /// It is undefined behavior to access the front element of an empty fifo.
+  /// Only the reader may access the front element.
+  ///
+        reference front()       { return front_segment().front(); }
+  /// @}
+
+  ///
+  /// @name Modifiers
+  /// @{
+  ///
+  /// It is undefined behavior to pop from an empty fifo, or to push onto a
+  /// full fifo.
+  ///
+  void clear() { discard(size()); }
+  void pop() { discard(1u); }
+  void push(const value_type&  value) { write(&value, 1u); }
+  void push(      value_type&& value) {
+    write(std::make_move_iterator(&value), 1u);
+  }
+  /// @}
+
+  /// Number of elements transferred by the last \c discard or \c read
+  size_type  last_read_size() const noexcept { return  _read.recent(); }
+  /// Number of elements transferred by the last \c write
+  size_type last_write_size() const noexcept { return _write.recent(); }
+
+  ///
+  /// Discard elements
+  ///
+  /// @param num Number of elements to discard
+  /// @return Number of elements discarded
+  ///
+  size_type discard(size_type num) {
+    return transfer_out(num, [](segment_type& s, size_type n) {
+      return s.discard(n);
+    });
+  }
+
+  ///
+  /// Read elements
+  ///
+  /// @param dst Destination of elements
+  /// @param num Number of elements to read
+  /// @return First destination position not written
+  ///
+  /// The number of elements read may be less than the number requested
+  /// if the buffer becomes empty.
+  ///
+  template <typename output_iterator>
+  output_iterator read(output_iterator dst, size_type num) {
+    transfer_out(num, [&](segment_type& s, size_type n) {
+      dst = s.read(dst, n);
+      return s.last_read_size();
+    });
+    return dst;
+  }
+
+  ///
+  /// Write elements
+  ///
+  /// @param src Source of elements
+  /// @param num Number of elements to write
+  /// @return First source position not read
+  ///
+  /// The number of elements written may be less than the number requested
+  /// only if the fifo reaches its maximum capacity.
+  ///
+  template <typename input_iterator>
+  input_iterator write(input_iterator src, size_type num);
+
+private:
+
+  struct segment {
+    segment(size_type count, wake_policy policy, const allocator_type& alloc)
+      : data(count, policy, alloc)
+    { }
+    segment_type data;
+    std::atomic<segment *> next {nullptr};
+  };
+  using segment_allocator =
+    typename std::allocator_traits<A>::template rebind_alloc<segment>;
+  using segment_traits = std::allocator_traits<segment_allocator>;
+
+  segment * make_segment(size_type count) {
+    segment_allocator alloc(_allocator);
+    auto p = segment_traits::allocate(alloc, 1u);
+    try {
+      segment_traits::construct(alloc, p, count, _policy, _allocator);
+    } catch (...) {
+      segment_traits::deallocate(alloc, p, 1u);
+      throw;
+    }
+    return p;
+  }
+
+  void destroy_segment(segment * p) {
+    segment_allocator alloc(_allocator);
+    segment_traits::destroy(alloc, p);
+    segment_traits::deallocate(alloc, p, 1u);
+  }
+
+  /// Link a segment of the given capacity after the tail, as the writer
+  void link_segment(size_type count) {
+    auto p = make_segment(count);
+    _tail->next.store(p, std::memory_order::release);
+    _tail = p;
+    _low_writes = 0u;
+  }
+
+  ///
+  /// Move to the next segment if the head is exhausted, as the reader
+  ///
+  /// The writer completes all writes to a segment before linking the next,
+  /// so once the next segment is visible, emptiness of the head is final.
+  ///
+  bool advance_head() {
+    auto next = _head->next.load(std::memory_order::acquire);
+    if (not next or not _head->data.empty()) return false;
+    destroy_segment(_head);
+    _head = next;
+    return true;
+  }
+
+  segment_type& front_segment() {
+    while (_head->data.empty() and advance_head()) { }
+    return _head->data;
+  }
+
+  template <typename F> size_type transfer_out(size_type num, F segment_op) {
+    _read.reset_recent();
+    num = std::min(num, size());
+    while (num) {
+      auto n = segment_op(_head->data, num);
+      if (n) _read.increase_weak(n, wrap, _policy);
+      num -= n;
+      if (num and not advance_head()) break;
+    }
+    return last_read_size();
+  }
+
+  ///
+  /// The totals are kept in buffer_direction objects to share fifo's waiting
+  /// protocol.  Their storage offsets are unused, so they never wrap.
+  ///
+  static constexpr size_type wrap = std::numeric_limits<size_type>::max();
+
+  growth_policy  _sizing;
+  wake_policy    _policy;
+  allocator_type _allocator;
+  alignas(align) segment * _head;       ///< Segment being read
+                 direction_data _read;
+  alignas(align) segment * _tail;       ///< Segment being written
+                 size_type _low_writes = 0u;
+                 direction_data _write;
+};
+
+template <typename T, unsigned align, typename A>
+template <typename input_iterator>
+input_iterator
+growable_fifo<T,align,A>::write(input_iterator src, size_type num) {
+  _write.reset_recent();
+  if (_sizing.shrink_after and _tail->data.capacity() > _sizing.initial) {
+    if (size() <= _tail->data.capacity() / 4u) {
+      if (++_low_writes >= _sizing.shrink_after) {
+        link_segment(std::max(_sizing.initial, _tail->data.capacity() / 2u));
+      }
+    } else {
+      _low_writes = 0u;
+    }
+  }
+  while (num) {
+    auto& data = _tail->data;
+    if (data.full()) {
+      if (data.capacity() >= _sizing.maximum) break;
+      auto larger = data.capacity() > _sizing.maximum / 2u
+        ? _sizing.maximum : 2u * data.capacity();
+      link_segment(larger);
+      continue;
+    }
+    src = data.write(src, num);
+    auto n = data.last_write_size();
+    _write.increase_weak(n, wrap, _policy);
+    num -= n;
+  }
+  return src;
+}
+
+}
+
+#endif
@@ -0,0 +1,152 @@
+//
+// Copyright (c) 2026
+// Kyle Markley.  All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+// 3. Neither the name of the author nor the names of any contributors may be
+//    used to endorse or promote products derived from this software without
+//    specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include "arrtest/arrtest.hpp"
+#include "arr/growable_fifo.hpp"
+#include <array>
+#include <iostream>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+UNIT_TEST_MAIN
+
+using namespace arr;
+using namespace std;
+
+using fifo_t = growable_fifo<int>;
+
+SUITE(single) {
+
+  TEST(initial) {
+    fifo_t buf({.initial = 4});
+    CHECK_EQUAL(4u, buf.capacity());
+    CHECK_EQUAL(true, buf.empty());
+    CHECK_EQUAL(false, buf.full());
+    CHECK_EQUAL(0u, buf.size());
+  }
+
+  TEST(grow_in_order) {
+    fifo_t buf({.initial = 2});
+    vector<int> in(100);
+    iota(in.begin(), in.end(), 0);
+    CHECK_EQUAL(in.end(), buf.write(in.begin(), in.size()));
+    CHECK_EQUAL(100u, buf.last_write_size());
+    CHECK_EQUAL(100u, buf.size());
+    CHECK_EQUAL(64u, buf.capacity());
+    vector<int> out(100);
+    CHECK_EQUAL(out.end(), buf.read(out.begin(), out.size()));
+    CHECK_EQUAL(100u, buf.last_read_size());
+    CHECK_EQUAL(true, buf.empty());
+    CHECK_RANGE_EQUAL(in.begin(), out.begin(), 100);
+  }
+
+  TEST(interleaved) {
+    fifo_t buf({.initial = 2});
+    int next_in = 0;
+    int next_out = 0;
+    for (int round = 0; round < 50; ++round) {
+      for (int i = 0; i < round % 7 + 1; ++i) buf.push(next_in++);
+      for (int i = 0; i < round % 5 and not buf.empty(); ++i) {
+        CHECK_EQUAL(next_out++, buf.front());
+        buf.pop();
+      }
+    }
+    while (not buf.empty()) {
+      CHECK_EQUAL(next_out++, buf.front());
+      buf.pop();
+    }
+    CHECK_EQUAL(next_in, next_out);
+  }
+
+  TEST(maximum) {
+    fifo_t buf({.initial = 2, .maximum = 8});
+    array<int, 20> in = {};
+    auto end = buf.write(in.begin(), in.size());
+    // Segments of 2, 4 and 8 are filled before the maximum is reached
+    CHECK_EQUAL(14, end - in.begin());
+    CHECK_EQUAL(true, buf.full());
+    CHECK_EQUAL(1u, buf.discard(1u));
+    CHECK_EQUAL(true, buf.full());  // Space freed in an older segment
+    CHECK_EQUAL(7u, buf.discard(7u));
+    CHECK_EQUAL(false, buf.full());
+  }
+
+  TEST(shrink) {
+    fifo_t buf({.initial = 2, .shrink_after = 3});
+    array<int, 32> in = {};
+    buf.write(in.begin(), in.size());
+    CHECK_EQUAL(32u, buf.capacity());
+    buf.clear();
+    for (int i = 0; i < 3; ++i) {
+      buf.push(i);
+      buf.pop();
+    }
+    CHECK_EQUAL(16u, buf.capacity());
+    for (int i = 0; i < 12; ++i) {
+      buf.push(i);
+      CHECK_EQUAL(i, buf.front());
+      buf.pop();
+    }
+    CHECK_EQUAL(2u, buf.capacity());
+  }
+
+}
+
+SUITE(concurrent) {
+
+  TEST(producer_consumer) {
+    const size_t total = 1000000u;
+    fifo_t buf({.initial = 4, .shrink_after = 16});
+    thread producer([&] {
+      vector<size_t> block(37);
+      size_t next = 0;
+      while (next < total) {
+        auto n = min(block.size(), total - next);
+        for (size_t i = 0; i < n; ++i) block[i] = next + i;
+        buf.write(block.begin(), n);
+        next += n;
+      }
+    });
+    vector<size_t> block(53);
+    size_t expected = 0;
+    bool in_order = true;
+    while (expected < total) {
+      if (buf.empty()) buf.wait_for_write();
+      auto end = buf.read(block.begin(), block.size());
+      for (auto i = block.begin(); i != end; ++i) {
+        in_order = in_order and *i == expected++;
+      }
+    }
+    producer.join();
+    CHECK_EQUAL(true, in_order);
+    CHECK_EQUAL(total, buf.read_total());
+  }
+
+}
@@ -0,0 +1,443 @@
+//
+// Copyright (c) 2026
+// Kyle Markley.  All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+// 3. Neither the name of the author nor the names of any contributors may be
+//    used to endorse or promote products derived from this software without
+//    specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include "arr/incremental_scan.hpp"
+#include "arr/cstdio.hpp"
+#include "arr/cstdlib.hpp"
+#include "arr/fcntl.hpp"
+#include "arr/file_descriptor.hpp"
+#include "arr/memory_map.hpp"
+#include "arr/mman.hpp"
+#include "arr/unistd.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <limits>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using namespace arr;
+
+constexpr char magic[8] = "arrscan";
+constexpr std::uint32_t version = 1u;
+constexpr std::size_t none = std::numeric_limits<std::size_t>::max();
+
+struct index_header {
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t record_size;
+  std::uint64_t records;
+  std::uint64_t names;          ///< Bytes of names
+  std::int64_t started;         ///< When the scan began, in ns since epoch
+};
+
+///
+/// Entry of a snapshot
+///
+/// The first record is the root.  The entries of a directory are the
+/// \c count records from \c first, sorted by name.
+///
+struct index_record {
+  std::int64_t mtime;           ///< ns since epoch
+  std::uint64_t size;
+  std::uint64_t inode;
+  std::uint64_t name;           ///< Offset of the name
+  std::uint32_t first;
+  std::uint32_t count;
+  std::uint8_t type;
+};
+
+std::int64_t since_epoch(const struct timespec& t) noexcept {
+  return std::int64_t(t.tv_sec) * 1000000000 + t.tv_nsec;
+}
+
+index_record make_record(const struct stat& sb) noexcept {
+  index_record r{};
+  r.mtime = since_epoch(sb.st_mtim);
+  r.size = static_cast<std::uint64_t>(sb.st_size);
+  r.inode = static_cast<std::uint64_t>(sb.st_ino);
+  r.type = static_cast<std::uint8_t>(IFTODT(sb.st_mode));
+  return r;
+}
+
+bool same(const index_record& a, const index_record& b) noexcept {
+  return a.type == b.type and a.mtime == b.mtime and
+    a.size == b.size and a.inode == b.inode;
+}
+
+///
+/// Previous snapshot, mapped from the index file
+///
+struct snapshot {
+  snapshot(const std::string& path);
+  bool empty() const noexcept { return 0u == size; }
+  std::string_view name(std::size_t i) const noexcept {
+    return names + records[i].name;
+  }
+  /// Index of the entry of directory \c dir with a name, or none
+  std::size_t find(std::size_t dir, std::string_view n) const noexcept;
+  /// Forget a malformed index, as if there were none
+  void discard() noexcept;
+  wrap::memory_map map;
+  const index_record * records = nullptr;
+  std::size_t size = 0u;
+  const char * names = nullptr;
+  std::int64_t started = std::numeric_limits<std::int64_t>::min();
+};
+
+snapshot::snapshot(const std::string& path) {
+  wrap::file_descriptor fd;
+  try {
+    fd = wrap::open(SOURCE_CONTEXT, path.c_str(), O_RDONLY|O_CLOEXEC, 0);
+  } catch (syscall_exception& e) {
+    if (ENOENT == e.code().value()) return;
+    throw;
+  }
+  struct stat sb;
+  wrap::fstat(SOURCE_CONTEXT, fd.get(), &sb);
+  auto length = static_cast<std::size_t>(sb.st_size);
+  if (length < sizeof(index_header)) return;
+  map = wrap::memory_map(wrap::mmap(SOURCE_CONTEXT, nullptr, length,
+        PROT_READ, MAP_PRIVATE, fd.get(), 0), length);
+  auto base = static_cast<const char *>(map.get());
+  index_header h;
+  std::memcpy(&h, base, sizeof(h));
+  auto available = length - sizeof(h);
+  if (0 != std::memcmp(h.magic, magic, sizeof(magic)) or
+      version != h.version or sizeof(index_record) != h.record_size or
+      0u == h.records or
+      h.records > available / sizeof(index_record) or
+      h.names != available - h.records * sizeof(index_record) or
+      0u == h.names or '\0' != base[length - 1u]) {
+    discard();
+    return;
+  }
+  records = static_cast<const index_record *>(
+      static_cast<const void *>(base + sizeof(h)));
+  size = h.records;
+  names = base + sizeof(h) + size * sizeof(index_record);
+  // Entries follow their directory, so that no directory contains itself
+  for (std::size_t i = 0; i < size; ++i) {
+    auto& r = records[i];
+    if (r.name >= h.names or std::size_t(r.first) + r.count > size or
+        (0u != r.count and r.first <= i)) {
+      discard();
+      return;
+    }
+  }
+  started = h.started;
+}
+
+void snapshot::discard() noexcept {
+  map = wrap::memory_map();
+  records = nullptr;
+  size = 0u;
+  names = nullptr;
+}
+
+std::size_t snapshot::find(std::size_t dir, std::string_view n) const noexcept {
+  auto& d = records[dir];
+  std::size_t lo = d.first;
+  std::size_t hi = std::size_t(d.first) + d.count;
+  while (lo < hi) {
+    auto mid = lo + (hi - lo) / 2u;
+    auto c = name(mid).compare(n);
+    if (0 == c) return mid;
+    if (c < 0) lo = mid + 1u; else hi = mid;
+  }
+  return none;
+}
+
+///
+/// Builder of the new snapshot, comparing with the previous one
+///
+struct scanner {
+  const snapshot& old;
+  const incremental_options& options;
+  incremental_scan::visitor_type& visitor;
+  std::list<std::unique_ptr<syscall_exception>>& exceptions;
+  std::int64_t trusted;         ///< Timestamps before this are trusted
+  scan_statistics stats;
+  std::vector<index_record> records;
+  std::string names;
+
+  struct child {
+    index_record record;
+    std::string name;
+    std::size_t prior;          ///< Index in the previous snapshot, or none
+  };
+
+  void report(scan_change c, const std::string& path, unsigned char type) {
+    visitor(scan_event{c, path, type});
+  }
+  bool racy(const index_record& r) const noexcept { return r.mtime >= trusted; }
+  bool stat(int fd, const char * name, index_record& r);
+  void walk(int fd, std::size_t self, std::size_t prior, std::string& path);
+  void compare(child& c, std::string& path);
+  void removed(std::size_t prior, std::string& path);
+  void added(std::size_t self, std::string& path);
+  void copy(std::size_t self, std::size_t prior);
+  std::size_t append(const index_record& r, std::string_view name);
+};
+
+bool scanner::stat(int fd, const char * name, index_record& r) {
+  ++stats.entries_stated;
+  try {
+    struct stat sb;
+    wrap::fstatat(SOURCE_CONTEXT, fd, name, &sb, AT_SYMLINK_NOFOLLOW);
+    r = make_record(sb);
+    return true;
+  } catch (syscall_exception& e) {
+    // An entry removed during the scan is simply absent
+    if (ENOENT != e.code().value()) exceptions.emplace_back(e.clone());
+    return false;
+  }
+}
+
+std::size_t scanner::append(const index_record& r, std::string_view name) {
+  records.push_back(r);
+  records.back().name = names.size();
+  records.back().first = 0u;
+  records.back().count = 0u;
+  names.append(name);
+  names.push_back('\0');
+  return records.size() - 1u;
+}
+
+void scanner::removed(std::size_t prior, std::string& path) {
+  auto& r = old.records[prior];
+  report(scan_change::removed, path, r.type);
+  if (DT_DIR != r.type) return;
+  auto size = path.size();
+  for (std::size_t i = r.first; i < std::size_t(r.first) + r.count; ++i) {
+    path.append(1u, '/').append(old.name(i));
+    removed(i, path);
+    path.resize(size);
+  }
+}
+
+void scanner::copy(std::size_t self, std::size_t prior) {
+  auto& r = old.records[prior];
+  records[self].first = static_cast<std::uint32_t>(records.size());
+  records[self].count = r.count;
+  for (std::size_t i = r.first; i < std::size_t(r.first) + r.count; ++i) {
+    append(old.records[i], old.name(i));
+  }
+  for (std::size_t i = 0; i < r.count; ++i) {
+    if (DT_DIR == old.records[r.first + i].type) {
+      copy(records[self].first + i, r.first + i);
+    }
+  }
+}
+
+void scanner::compare(child& c, std::string& path) {
+  if (none != c.prior and old.records[c.prior].type != c.record.type) {
+    removed(c.prior, path);
+    c.prior = none;
+  }
+  if (none == c.prior) {
+    report(scan_change::added, path, c.record.type);
+  } else if (DT_DIR != c.record.type and
+      (not same(old.records[c.prior], c.record) or racy(c.record))) {
+    report(scan_change::modified, path, c.record.type);
+  }
+}
+
+void scanner::walk(int fd, std::size_t self, std::size_t prior,
+    std::string& path) {
+  std::vector<child> children;
+  auto size = path.size();
+  if (none != prior and same(old.records[prior], records[self]) and
+      not racy(records[self])) {
+    // The listing is unchanged; only entries may have been modified
+    ++stats.directories_skipped;
+    auto& o = old.records[prior];
+    for (std::size_t i = o.first; i < std::size_t(o.first) + o.count; ++i) {
+      child c{old.records[i], std::string(old.name(i)), i};
+      path.append(1u, '/').append(c.name);
+      if (DT_DIR == c.record.type or options.verify_files) {
+        if (stat(fd, c.name.c_str(), c.record)) {
+          compare(c, path);
+          children.push_back(std::move(c));
+        } else {
+          removed(i, path);
+        }
+      } else {
+        children.push_back(std::move(c));
+      }
+      path.resize(size);
+    }
+  } else {
+    ++stats.directories_read;
+    directory_sequence ds(fd, ".", path, options.directory);
+    for (auto i = ds.begin(); i != ds.end(); ++i) {
+      child c{{}, i->d_name, none};
+      if (stat(fd, i->d_name, c.record)) {
+        if (none != prior) c.prior = old.find(prior, c.name);
+        children.push_back(std::move(c));
+      }
+    }
+    exceptions.splice(exceptions.end(), ds.exceptions);
+    std::sort(children.begin(), children.end(),
+        [](const child& a, const child& b) { return a.name < b.name; });
+    // Entries of the previous listing not found are removed
+    if (none != prior) {
+      auto& o = old.records[prior];
+      auto next = children.begin();
+      for (std::size_t i = o.first; i < std::size_t(o.first) + o.count; ++i) {
+        auto n = old.name(i);
+        while (next != children.end() and next->name < n) ++next;
+        if (next != children.end() and next->name == n) continue;
+        path.append(1u, '/').append(n);
+        removed(i, path);
+        path.resize(size);
+      }
+    }
+    for (auto& c : children) {
+      path.append(1u, '/').append(c.name);
+      compare(c, path);
+      path.resize(size);
+    }
+  }
+
+  auto first = records.size();
+  records[self].first = static_cast<std::uint32_t>(first);
+  records[self].count = static_cast<std::uint32_t>(children.size());
+  for (auto& c : children) append(c.record, c.name);
+
+  for (std::size_t k = 0; k < children.size(); ++k) {
+    auto& c = children[k];
+    if (DT_DIR != c.record.type) continue;
+    path.append(1u, '/').append(c.name);
+    try {
+      wrap::file_descriptor sub = wrap::openat(SOURCE_CONTEXT, fd,
+          c.name.c_str(), O_RDONLY|O_DIRECTORY|O_NOFOLLOW|O_CLOEXEC, 0);
+      walk(sub.get(), first + k, c.prior, path);
+    } catch (syscall_exception& e) {
+      // Keep what was known of a directory that cannot be read
+      exceptions.emplace_back(e.clone());
+      if (none != c.prior) copy(first + k, c.prior);
+    }
+    path.resize(size);
+  }
+}
+
+void write_index(const std::string& path, std::int64_t started,
+    const std::vector<index_record>& records, const std::string& names) {
+  index_header h{};
+  std::memcpy(h.magic, magic, sizeof(magic));
+  h.version = version;
+  h.record_size = sizeof(index_record);
+  h.records = records.size();
+  h.names = names.size();
+  h.started = started;
+  //
+  // Write a file of a unique name beside the index, so that concurrent
+  // scans do not share it, and make it durable before it replaces the
+  // index.  The directory is then synchronized so that the rename is too.
+  //
+  auto temporary = path + ".XXXXXX";
+  wrap::file_descriptor fd = wrap::mkstemp(SOURCE_CONTEXT, temporary.data());
+  auto put = [&](const void * data, std::size_t size) {
+    auto p = static_cast<const char *>(data);
+    while (size) {
+      auto n = wrap::write(SOURCE_CONTEXT, fd.get(), p, size);
+      p += n;
+      size -= n;
+    }
+  };
+  try {
+    put(&h, sizeof(h));
+    put(records.data(), records.size() * sizeof(index_record));
+    put(names.data(), names.size());
+    wrap::fsync(SOURCE_CONTEXT, fd.get());
+    fd.close();
+    wrap::rename(SOURCE_CONTEXT, temporary.c_str(), path.c_str());
+  } catch (...) {
+    ::unlink(temporary.c_str());
+    throw;
+  }
+  auto slash = path.rfind('/');
+  auto directory = std::string::npos == slash ? std::string(".")
+    : 0u == slash ? std::string("/") : path.substr(0, slash);
+  wrap::file_descriptor dir = wrap::open(SOURCE_CONTEXT, directory.c_str(),
+      O_RDONLY|O_DIRECTORY|O_CLOEXEC, 0);
+  wrap::fsync(SOURCE_CONTEXT, dir.get());
+}
+
+}
+
+namespace arr {
+
+std::ostream& operator<<(std::ostream& o, scan_change change) {
+  switch (change) {
+    case scan_change::added:    return o << "added";
+    case scan_change::removed:  return o << "removed";
+    case scan_change::modified: return o << "modified";
+  }
+  return o;
+}
+
+incremental_scan::incremental_scan(
+    std::string directory,
+    std::string index,
+    incremental_options options)
+  : _root(std::move(directory))
+  , _index(std::move(index))
+  , _options(options)
+{
+  while (_root.size() > 1u and '/' == _root.back()) _root.pop_back();
+}
+
+scan_statistics incremental_scan::run(visitor_type visitor) {
+  using namespace std::chrono;
+  auto started = duration_cast<nanoseconds>(
+      system_clock::now().time_since_epoch()).count();
+  snapshot old(_index);
+  auto trusted = old.empty() ? started
+    : old.started - std::min(old.started, _options.granularity.count());
+  scanner s{old, _options, visitor, exceptions, trusted, {}, {}, {}};
+
+  wrap::file_descriptor fd = wrap::open(SOURCE_CONTEXT, _root.c_str(),
+      O_RDONLY|O_DIRECTORY|O_CLOEXEC, 0);
+  struct stat sb;
+  wrap::fstat(SOURCE_CONTEXT, fd.get(), &sb);
+  s.append(make_record(sb), "");
+  std::string path = "/" == _root ? "" : _root;
+  s.walk(fd.get(), 0u, old.empty() ? none : 0u, path);
+
+  write_index(_index, started, s.records, s.names);
+  s.stats.entries = s.records.size();
+  return s.stats;
+}
+
+}
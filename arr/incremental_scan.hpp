@@ -0,0 +1,158 @@
+#ifndef ARR_INCREMENTAL_SCAN_HPP
+#define ARR_INCREMENTAL_SCAN_HPP
+//
+// Copyright (c) 2026
+// Kyle Markley.  All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+// 3. Neither the name of the author nor the names of any contributors may be
+//    used to endorse or promote products derived from this software without
+//    specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include "arr/directory_sequence.hpp"
+#include "arr/syscall_exception.hpp"
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <ostream>
+#include <string>
+
+namespace arr {
+
+/// \addtogroup directory_traversal
+/// @{
+
+///
+/// Kind of difference found by an incremental scan
+///
+enum class scan_change {
+  added,        ///< Entry not in the previous snapshot
+  removed,      ///< Entry in the previous snapshot, but not the tree
+  modified,     ///< Non-directory whose mtime, size, or inode changed
+};
+
+std::ostream& operator<<(std::ostream& o, scan_change change);
+
+///
+/// Difference reported by an incremental scan
+///
+struct scan_event {
+  scan_change change;
+  const std::string& path;      ///< Path, beginning with the root
+  unsigned char type;           ///< Type, as \c dirent::d_type
+};
+
+///
+/// Options for an incremental scan
+///
+struct incremental_options {
+  bool verify_files = true;     ///< Stat files in unchanged directories
+  std::chrono::nanoseconds granularity = std::chrono::seconds(1);
+                                ///< Timestamps this close to the previous
+                                ///< scan are not trusted
+  directory_options directory;  ///< Options for reading directories
+};
+
+///
+/// Work done by an incremental scan
+///
+struct scan_statistics {
+  std::uint64_t directories_read = 0u;          ///< Listings read
+  std::uint64_t directories_skipped = 0u;       ///< Listings from snapshot
+  std::uint64_t entries_stated = 0u;            ///< Calls to fstatat
+  std::uint64_t entries = 0u;                   ///< Entries in new snapshot
+};
+
+///
+/// Directory tree scan reporting changes since a persistent snapshot
+///
+/// Each run compares the tree with the snapshot in the index file left by
+/// the previous run, reports the differences, and replaces the index with a
+/// new snapshot.  Without an index, or with one that is not a valid
+/// snapshot, every entry is reported as added.
+///
+/// A directory's mtime changes whenever an entry is added to, removed from,
+/// or renamed within it.  So a directory whose mtime and inode match the
+/// snapshot is not read: its entries are taken from the snapshot.  Its
+/// subdirectories are still examined, since changes deeper in the tree do
+/// not propagate upward.  Its files are examined with fstatat to find
+/// modifications, unless \c verify_files is false, in which case only
+/// additions and removals are found and the cost of a rescan is
+/// proportional to the number of directories and the volume of change.
+///
+/// A timestamp at or after the previous scan began, less the granularity,
+/// may not reflect a change made during that scan.  Such a directory is
+/// read, and such a file is reported as modified.
+///
+/// The index is a flat file holding, for each entry, its mtime, size, inode,
+/// type, and name, with the entries of each directory stored together and
+/// sorted by name.  It is mapped into memory rather than parsed.  It is
+/// written to a uniquely named temporary file beside it, synchronized to
+/// disk, and renamed into place, so that a crash leaves either the old or
+/// the new snapshot.
+///
+/// Symbolic links are not followed.
+///
+struct incremental_scan {
+  using visitor_type = std::function<void(const scan_event&)>;
+
+  ///
+  /// @param directory Root of the tree
+  /// @param index     Path of the index file
+  /// @param options   Options for the scan
+  ///
+  incremental_scan(
+      std::string directory,
+      std::string index,
+      incremental_options options = {});
+
+  ///
+  /// Scan the tree, calling the visitor for each difference
+  ///
+  /// An index file that is not a valid snapshot is ignored, as if it were
+  /// missing, and replaced.  Errors within the tree are recorded in
+  /// \c exceptions; the snapshot keeps the previous contents of a directory
+  /// that could not be opened.
+  ///
+  scan_statistics run(visitor_type visitor);
+
+  const std::string& root() const noexcept { return _root; }
+  const std::string& index() const noexcept { return _index; }
+
+  ///
+  /// Exceptions encountered during directory traversal
+  ///
+  std::list<std::unique_ptr<syscall_exception>> exceptions;
+private:
+  std::string _root;
+  std::string _index;
+  incremental_options _options;
+};
+
+/// @}
+
+}
+
+#endif
@@ -0,0 +1,215 @@
+//
+// Copyright (c) 2026
+// Kyle Markley.  All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+// 3. Neither the name of the author nor the names of any contributors may be
+//    used to endorse or promote products derived from this software without
+//    specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include "arrtest/arrtest.hpp"
+#include "arr/incremental_scan.hpp"
+#include "arr/directory_sequence.hpp"
+#include "arr/fcntl.hpp"
+#include "arr/file_descriptor.hpp"
+#include "arr/temp_dir.hpp"
+#include "arr/unistd.hpp"
+#include <chrono>
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+
+UNIT_TEST_MAIN
+
+using namespace arr;
+using namespace std;
+
+namespace {
+
+void put(const string& path, const string& data) {
+  wrap::file_descriptor fd = wrap::open(SOURCE_CONTEXT,
+      path.c_str(), O_WRONLY|O_CREAT|O_TRUNC, 0600);
+  if (not data.empty()) {
+    wrap::write(SOURCE_CONTEXT, fd.get(), data.data(), data.size());
+  }
+}
+
+// Options trusting timestamps as soon as the scan is done
+incremental_options precise() {
+  incremental_options options;
+  options.granularity = {};
+  return options;
+}
+
+// Root, its index, and a tree of three directories and three files
+struct tree {
+  tree()
+    : root(string(dir.name()) + "/root")
+    , index(string(dir.name()) + "/index")
+  {
+    wrap::mkdir(SOURCE_CONTEXT, root.c_str(), 0700);
+    wrap::mkdir(SOURCE_CONTEXT, (root + "/d").c_str(), 0700);
+    wrap::mkdir(SOURCE_CONTEXT, (root + "/d/e").c_str(), 0700);
+    put(root + "/a", "a");
+    put(root + "/b", "b");
+    put(root + "/d/e/f", "f");
+  }
+  // Events as "change path" relative to the root
+  set<string> scan(incremental_options options = precise()) {
+    set<string> events;
+    incremental_scan s(root, index, options);
+    stats = s.run([&](const scan_event& e) {
+      ostringstream o;
+      o << e.change << ' ' << e.path.substr(root.size());
+      events.insert(o.str());
+    });
+    return events;
+  }
+  // Let timestamps move past the previous scan
+  static void later() { this_thread::sleep_for(50ms); }
+  temp_dir dir;
+  string root;
+  string index;
+  scan_statistics stats;
+};
+
+}
+
+SUITE(changes) {
+
+  TEST(initial) {
+    tree t;
+    set<string> expected = { "added /a", "added /b", "added /d",
+      "added /d/e", "added /d/e/f" };
+    CHECK_EQUAL(true, expected == t.scan());
+    CHECK_EQUAL(3u, t.stats.directories_read);
+    CHECK_EQUAL(0u, t.stats.directories_skipped);
+    CHECK_EQUAL(6u, t.stats.entries);
+  }
+
+  TEST(unchanged) {
+    tree t;
+    t.scan();
+    t.later();
+    CHECK_EQUAL(0u, t.scan().size());
+    CHECK_EQUAL(0u, t.stats.directories_read);
+    CHECK_EQUAL(3u, t.stats.directories_skipped);
+    CHECK_EQUAL(6u, t.stats.entries);
+  }
+
+  TEST(modified) {
+    tree t;
+    t.scan();
+    t.later();
+    put(t.root + "/a", "longer");
+    wrap::unlink(SOURCE_CONTEXT, (t.root + "/d/e/f").c_str());
+    put(t.root + "/d/g", "");
+    set<string> expected = { "modified /a", "removed /d/e/f", "added /d/g" };
+    CHECK_EQUAL(true, expected == t.scan());
+    CHECK_EQUAL(2u, t.stats.directories_read);
+    CHECK_EQUAL(1u, t.stats.directories_skipped);
+    t.later();
+    CHECK_EQUAL(0u, t.scan().size());
+  }
+
+  TEST(subtrees) {
+    tree t;
+    t.scan();
+    t.later();
+    wrap::unlink(SOURCE_CONTEXT, (t.root + "/d/e/f").c_str());
+    wrap::rmdir(SOURCE_CONTEXT, (t.root + "/d/e").c_str());
+    wrap::mkdir(SOURCE_CONTEXT, (t.root + "/n").c_str(), 0700);
+    put(t.root + "/n/x", "");
+    wrap::unlink(SOURCE_CONTEXT, (t.root + "/b").c_str());
+    wrap::mkdir(SOURCE_CONTEXT, (t.root + "/b").c_str(), 0700);
+    set<string> expected = { "removed /d/e", "removed /d/e/f",
+      "added /n", "added /n/x", "removed /b", "added /b" };
+    CHECK_EQUAL(true, expected == t.scan());
+  }
+
+  TEST(unverified_files) {
+    tree t;
+    t.scan();
+    t.later();
+    put(t.root + "/b", "changed");
+    auto options = precise();
+    options.verify_files = false;
+    CHECK_EQUAL(0u, t.scan(options).size());
+    CHECK_EQUAL(2u, t.stats.entries_stated);      // Directories d and e
+    set<string> expected = { "modified /b" };
+    CHECK_EQUAL(true, expected == t.scan());
+  }
+
+  TEST(racy) {
+    tree t;
+    t.scan({});
+    // Within the default granularity of the previous scan
+    set<string> expected = { "modified /a", "modified /b", "modified /d/e/f" };
+    CHECK_EQUAL(true, expected == t.scan({}));
+    CHECK_EQUAL(3u, t.stats.directories_read);
+  }
+
+}
+
+SUITE(errors) {
+
+  TEST(invalid_index) {
+    tree t;
+    set<string> expected = { "added /a", "added /b", "added /d",
+      "added /d/e", "added /d/e/f" };
+    auto header = string("arrscan", sizeof("arrscan")) + string(40u, '\xff');
+    for (auto& data : { string("not an index"), header }) {
+      put(t.index, data);
+      CHECK_EQUAL(true, expected == t.scan());
+      CHECK_EQUAL(true, t.scan().empty());
+    }
+  }
+
+  TEST(cyclic_index) {
+    tree t;
+    t.scan();
+    // Make /d, the fourth record, its own entry.  A record is 48 bytes and
+    // its first entry is at offset 32, after a header of 40 bytes.
+    std::uint32_t self = 3u;
+    wrap::file_descriptor fd = wrap::open(SOURCE_CONTEXT,
+        t.index.c_str(), O_WRONLY, 0);
+    CHECK_EQUAL(ssize_t(sizeof(self)),
+        ::pwrite(fd.get(), &self, sizeof(self), 40 + 3 * 48 + 32));
+    set<string> expected = { "added /a", "added /b", "added /d",
+      "added /d/e", "added /d/e/f" };
+    CHECK_EQUAL(true, expected == t.scan());
+  }
+
+  TEST(no_temporary) {
+    tree t;
+    t.scan();
+    t.scan();
+    set<string> names;
+    directory_sequence ds(t.dir.name());
+    for (auto& entry : ds) names.insert(entry.d_name);
+    CHECK_EQUAL(true, (set<string>{ "index", "root" }) == names);
+  }
+
+}
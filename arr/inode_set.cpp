@@ -0,0 +1,139 @@
+//
+// Copyright (c) 2026
+// Kyle Markley.  All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+// 3. Neither the name of the author nor the names of any contributors may be
+//    used to endorse or promote products derived from this software without
+//    specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include "arr/inode_set.hpp"
+
+namespace arr {
+
+std::size_t inode_set::hash(
+    std::uint64_t device, std::uint64_t inode) noexcept {
+  // Finalizer of splitmix64
+  auto x = inode ^ (device << 32 | device >> 32);
+  x ^= x >> 30;
+  x *= 0xbf58476d1ce4e5b9u;
+  x ^= x >> 27;
+  x *= 0x94d049bb133111ebu;
+  x ^= x >> 31;
+  return static_cast<std::size_t>(x);
+}
+
+std::size_t inode_set::find(
+    std::uint64_t device, std::uint64_t inode) const noexcept {
+  auto mask = _slots.size() - 1u;
+  for (auto i = hash(device, inode) & mask; ; i = (i + 1u) & mask) {
+    auto& s = _slots[i];
+    if (none == s.device and none == s.inode) return i;
+    if (device == s.device and inode == s.inode) return i;
+  }
+}
+
+bool inode_set::insert(dev_t device, ino_t inode) {
+  auto d = static_cast<std::uint64_t>(device);
+  auto n = static_cast<std::uint64_t>(inode);
+  if (none == d and none == n) {
+    if (_has_none) return false;
+    _has_none = true;
+    ++_size;
+    return true;
+  }
+  if (_compact) {
+    if (not insert_bit(d, n)) return false;
+    ++_size;
+    return true;
+  }
+  auto used = _size - (_has_none ? 1u : 0u);    // Slots holding a file
+  if (8u * (used + 1u) > 7u * _slots.size()) {
+    grow();
+    if (_compact) return insert(device, inode);
+  }
+  auto& s = _slots[find(d, n)];
+  if (d == s.device and n == s.inode) return false;
+  s = slot{d, n};
+  ++_size;
+  return true;
+}
+
+bool inode_set::contains(dev_t device, ino_t inode) const noexcept {
+  auto d = static_cast<std::uint64_t>(device);
+  auto n = static_cast<std::uint64_t>(inode);
+  if (none == d and none == n) return _has_none;
+  if (_compact) {
+    auto p = _pages.find(page_key{d, n / page_bits});
+    if (_pages.end() == p) return false;
+    auto bit = n % page_bits;
+    return p->second[bit / 64u] >> (bit % 64u) & 1u;
+  }
+  if (_slots.empty()) return false;
+  auto& s = _slots[find(d, n)];
+  return d == s.device and n == s.inode;
+}
+
+void inode_set::clear() noexcept {
+  _slots.clear();
+  _slots.shrink_to_fit();
+  _pages.clear();
+  _size = 0u;
+  _has_none = false;
+  _compact = false;
+}
+
+void inode_set::grow() {
+  auto count = _slots.empty() ? 64u : 2u * _slots.size();
+  if (not _slots.empty() and count * sizeof(slot) > _max_table) {
+    //
+    // Move every file into bitmaps, and release the table
+    //
+    for (auto& s : _slots) {
+      if (none == s.device and none == s.inode) continue;
+      insert_bit(s.device, s.inode);
+    }
+    _slots = std::vector<slot>();
+    _compact = true;
+    return;
+  }
+  std::vector<slot> old(count, slot{none, none});
+  old.swap(_slots);
+  for (auto& s : old) {
+    if (none == s.device and none == s.inode) continue;
+    _slots[find(s.device, s.inode)] = s;
+  }
+}
+
+bool inode_set::insert_bit(std::uint64_t device, std::uint64_t inode) {
+  auto& page = _pages[page_key{device, inode / page_bits}];
+  if (not page) page.reset(new std::uint64_t[page_bits / 64u]());
+  auto bit = inode % page_bits;
+  auto& word = page[bit / 64u];
+  auto mask = std::uint64_t(1) << (bit % 64u);
+  if (word & mask) return false;
+  word |= mask;
+  return true;
+}
+
+}
@@ -0,0 +1,135 @@
+#ifndef ARR_INODE_SET_HPP
+#define ARR_INODE_SET_HPP
+//
+// Copyright (c) 2026
+// Kyle Markley.  All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+// 3. Neither the name of the author nor the names of any contributors may be
+//    used to endorse or promote products derived from this software without
+//    specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <sys/types.h>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace arr {
+
+///
+/// \ingroup directory_traversal
+/// Set of files identified by device and inode number
+///
+/// This is an open-addressing hash table of (device, inode) pairs, storing
+/// 16 bytes per slot with no per-element allocation, and kept at most 7/8
+/// full.  Traversals record only the files they must remember (directories
+/// that may be reached again, or files with several links), so that the set
+/// is usually small relative to the tree.
+///
+/// The table does not grow beyond \c max_table bytes.  When it would, the
+/// set becomes compact: each file is then one bit in a bitmap of the inode
+/// numbers of its device, allocated in pages of 4096 inode numbers as they
+/// are used.  Memory is then bounded by the range of inode numbers in use,
+/// about an eighth of a byte per inode of each filesystem, however many
+/// files are inserted; hundreds of millions of files from a filesystem that
+/// numbers its inodes densely take tens of megabytes.  Lookups are slower,
+/// and a filesystem with sparse inode numbers may use a page for few files.
+///
+struct inode_set {
+  using size_type = std::size_t;
+
+  /// Default bound on the size of the table
+  static constexpr size_type default_max_table = 64u * 1024u * 1024u;
+
+  ///
+  /// Construct an empty set
+  ///
+  /// @param max_table Largest table, in bytes, before the set becomes
+  ///                  compact
+  ///
+  explicit inode_set(size_type max_table = default_max_table) noexcept
+    : _max_table(max_table) { }
+
+  ///
+  /// Insert a file
+  ///
+  /// @return Whether the file was not already present
+  ///
+  bool insert(dev_t device, ino_t inode);
+
+  /// Whether a file is present
+  bool contains(dev_t device, ino_t inode) const noexcept;
+
+  size_type size() const noexcept { return _size; }
+  bool empty() const noexcept { return 0u == _size; }
+
+  /// Whether files are held in bitmaps rather than the table
+  bool compact() const noexcept { return _compact; }
+
+  /// Bytes of storage used by the table or bitmaps
+  size_type memory() const noexcept {
+    return _slots.capacity() * sizeof(slot) + _pages.size() * page_bytes;
+  }
+
+  void clear() noexcept;
+
+private:
+  struct slot {
+    std::uint64_t device;
+    std::uint64_t inode;
+  };
+  /// Identity of a bitmap page: a device and inode number / page_bits
+  struct page_key {
+    std::uint64_t device;
+    std::uint64_t page;
+    bool operator==(const page_key&) const = default;
+  };
+  struct page_hash {
+    std::size_t operator()(const page_key& k) const noexcept {
+      return inode_set::hash(k.device, k.page);
+    }
+  };
+  static constexpr std::size_t page_bits = 4096u;
+  static constexpr std::size_t page_bytes = page_bits / 8u;
+  /// Marks an empty slot; a file with this identity is tracked separately
+  static constexpr std::uint64_t none = ~std::uint64_t(0);
+  static std::size_t hash(std::uint64_t device, std::uint64_t inode) noexcept;
+  /// Index of the slot holding a file, or of the empty slot ending its probe
+  std::size_t find(std::uint64_t device, std::uint64_t inode) const noexcept;
+  void grow();
+  bool insert_bit(std::uint64_t device, std::uint64_t inode);
+  std::vector<slot> _slots;
+  std::unordered_map<page_key, std::unique_ptr<std::uint64_t[]>, page_hash>
+    _pages;
+  size_type _size = 0u;
+  size_type _max_table;
+  bool _has_none = false;
+  bool _compact = false;
+};
+
+}
+
+#endif
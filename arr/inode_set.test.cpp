@@ -0,0 +1,121 @@
+//
+// Copyright (c) 2026
+// Kyle Markley.  All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+// 3. Neither the name of the author nor the names of any contributors may be
+//    used to endorse or promote products derived from this software without
+//    specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include "arrtest/arrtest.hpp"
+#include "arr/inode_set.hpp"
+
+UNIT_TEST_MAIN
+
+using arr::inode_set;
+
+SUITE(behavior) {
+
+  TEST(empty) {
+    const inode_set s;
+    CHECK_EQUAL(true, s.empty());
+    CHECK_EQUAL(false, s.contains(1, 2));
+    CHECK_EQUAL(0u, s.memory());
+  }
+
+  TEST(insert) {
+    inode_set s;
+    CHECK_EQUAL(true , s.insert(1, 2));
+    CHECK_EQUAL(false, s.insert(1, 2));
+    CHECK_EQUAL(true , s.insert(2, 1));
+    CHECK_EQUAL(true , s.contains(1, 2));
+    CHECK_EQUAL(true , s.contains(2, 1));
+    CHECK_EQUAL(false, s.contains(1, 1));
+    CHECK_EQUAL(2u, s.size());
+  }
+
+  TEST(grow) {
+    inode_set s;
+    for (ino_t i = 0; i < 10000; ++i) {
+      CHECK_EQUAL(true, s.insert(static_cast<dev_t>(i % 3), i));
+    }
+    CHECK_EQUAL(10000u, s.size());
+    for (ino_t i = 0; i < 10000; ++i) {
+      CHECK_EQUAL(true , s.contains(static_cast<dev_t>(i % 3), i));
+      CHECK_EQUAL(false, s.contains(static_cast<dev_t>(i % 3 + 3), i));
+    }
+    CHECK_EQUAL(true, s.memory() <= 16u * 10000u * 2u);
+  }
+
+  TEST(sentinel) {
+    inode_set s;
+    auto d = static_cast<dev_t>(~0ull);
+    auto n = static_cast<ino_t>(~0ull);
+    CHECK_EQUAL(false, s.contains(d, n));
+    CHECK_EQUAL(true , s.insert(d, n));
+    CHECK_EQUAL(false, s.insert(d, n));
+    CHECK_EQUAL(true , s.contains(d, n));
+    CHECK_EQUAL(1u, s.size());
+  }
+
+  TEST(compact) {
+    inode_set s(4096u);
+    for (ino_t i = 0; i < 100000; ++i) {
+      CHECK_EQUAL(true, s.insert(static_cast<dev_t>(i % 2), i));
+    }
+    CHECK_EQUAL(true, s.compact());
+    CHECK_EQUAL(false, s.insert(1, 99999));
+    CHECK_EQUAL(100000u, s.size());
+    for (ino_t i = 0; i < 100000; ++i) {
+      CHECK_EQUAL(true , s.contains(static_cast<dev_t>(i % 2), i));
+      CHECK_EQUAL(false, s.contains(static_cast<dev_t>(i % 2 + 2), i));
+    }
+    CHECK_EQUAL(false, s.contains(0, 100000));
+    // Two devices, each with 100000 inode numbers in 512-byte pages
+    CHECK_EQUAL(true, s.memory() <= 2u * (100000u / 4096u + 1u) * 512u);
+  }
+
+  TEST(sentinel_not_in_table) {
+    // The sentinel takes no slot, so 56 files still fit the first table
+    inode_set s(1024u);
+    s.insert(static_cast<dev_t>(~0ull), static_cast<ino_t>(~0ull));
+    for (ino_t i = 0; i < 56; ++i) s.insert(1, i);
+    CHECK_EQUAL(false, s.compact());
+    CHECK_EQUAL(57u, s.size());
+    s.insert(1, 56);
+    CHECK_EQUAL(true, s.compact());
+    CHECK_EQUAL(true, s.contains(static_cast<dev_t>(~0ull),
+          static_cast<ino_t>(~0ull)));
+  }
+
+  TEST(clear) {
+    inode_set s;
+    s.insert(1, 2);
+    s.clear();
+    CHECK_EQUAL(true, s.empty());
+    CHECK_EQUAL(false, s.contains(1, 2));
+    CHECK_EQUAL(true, s.insert(1, 2));
+    CHECK_EQUAL(false, s.compact());
+  }
+
+}
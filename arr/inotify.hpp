@@ -0,0 +1,72 @@
+#ifndef WRAP_INOTIFY_HPP
+#define WRAP_INOTIFY_HPP
+//
+// Copyright (c) 2026
+// Kyle Markley.  All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+// 3. Neither the name of the author nor the names of any contributors may be
+//    used to endorse or promote products derived from this software without
+//    specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include "arr/source_context.hpp"
+
+#if defined(__linux__)
+#include <sys/inotify.h>
+#endif
+
+///
+/// \file
+/// \ingroup system_function_wrappers
+///
+/// Wrappers for functions in \c <sys/inotify.h>, on Linux
+///
+
+namespace wrap {
+
+/// \addtogroup system_function_wrappers
+/// @{
+
+#if defined(__linux__)
+///
+/// Wrapper for inotify_init1(2)
+///
+int inotify_init1(arr::source_context, int flags);
+
+///
+/// Wrapper for inotify_add_watch(2)
+///
+int inotify_add_watch(arr::source_context,
+    int fd, const char *path, unsigned mask);
+
+///
+/// Wrapper for inotify_rm_watch(2)
+///
+void inotify_rm_watch(arr::source_context, int fd, int wd);
+#endif
+
+/// @}
+
+}
+
+#endif
@@ -0,0 +1,80 @@
+#ifndef WRAP_MEMORY_MAP_HPP
+#define WRAP_MEMORY_MAP_HPP
+//
+// Copyright (c) 2026
+// Kyle Markley.  All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+// 3. Neither the name of the author nor the names of any contributors may be
+//    used to endorse or promote products derived from this software without
+//    specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <cstddef>
+#include <utility>
+
+namespace wrap {
+
+///
+/// \ingroup system_resources
+/// A memory mapping
+///
+struct memory_map {
+  using addr_t = void *;
+  ~memory_map() noexcept;
+  memory_map() noexcept { }
+  memory_map(addr_t address, std::size_t length) noexcept
+    : addr(address), len(length) { }
+  memory_map(const memory_map& ) = delete;
+  memory_map(      memory_map&&) noexcept;
+  memory_map& operator=(const memory_map& ) = delete;
+  memory_map& operator=(      memory_map&&) noexcept;
+  bool valid() const noexcept { return nullptr != addr; }
+  addr_t get() const noexcept { return addr; }
+  std::size_t size() const noexcept { return len; }
+  addr_t release() noexcept { auto r = get(); addr = nullptr; len = 0; return r; }
+  void close();
+private:
+  addr_t addr = nullptr;
+  std::size_t len = 0;
+};
+
+inline memory_map::memory_map(memory_map&& peer) noexcept
+  : addr(std::move(peer.addr))
+  , len(std::move(peer.len))
+{
+  peer.addr = nullptr;
+  peer.len = 0;
+}
+
+inline memory_map&
+memory_map::operator=(memory_map&& peer) noexcept {
+  auto& self = *this;
+  using std::swap;
+  swap(self.addr, peer.addr);
+  swap(self.len, peer.len);
+  return self;
+}
+
+}
+
+#endif
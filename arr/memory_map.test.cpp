@@ -0,0 +1,108 @@
+//
+// Copyright (c) 2026
+// Kyle Markley.  All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+// 3. Neither the name of the author nor the names of any contributors may be
+//    used to endorse or promote products derived from this software without
+//    specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include "arr/memory_map.hpp"
+#include "arr/mman.hpp"
+#include "arr/syscall_exception.hpp"
+#include <iostream>
+#include "arr/report.test.hpp"
+#include "arrtest/arrtest.hpp"
+
+using namespace std;
+
+UNIT_TEST_MAIN
+
+TEST(report) {
+  cout << "Operations of type: memory_map" << endl;
+  arr::report_operations<wrap::memory_map>(cout);
+}
+
+namespace {
+
+const size_t length = 4096u;
+
+wrap::memory_map anonymous() {
+  return { wrap::mmap(SOURCE_CONTEXT, nullptr, length,
+      PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANON, -1, 0), length };
+}
+
+}
+
+SUITE(behavior) {
+
+  TEST(default_const) {
+    const wrap::memory_map m;
+    CHECK_EQUAL(false, m.valid());
+    CHECK_EQUAL(static_cast<void*>(nullptr), m.get());
+    CHECK_EQUAL(0u, m.size());
+  }
+
+  TEST(mapped) {
+    auto m = anonymous();
+    CHECK_EQUAL(true, m.valid());
+    CHECK_EQUAL(length, m.size());
+    static_cast<char*>(m.get())[length-1] = 'x';
+    m.close();
+    CHECK_EQUAL(false, m.valid());
+    CHECK_EQUAL(0u, m.size());
+  }
+
+  TEST(map_error) {
+    try {
+      wrap::mmap(SOURCE_CONTEXT, nullptr, 0u, PROT_READ, MAP_PRIVATE|MAP_ANON, -1, 0);
+      CHECK_CATCH(arr::syscall_exception, e);
+      static_cast<void>(e);
+    }
+  }
+
+}
+
+SUITE(move) {
+
+  TEST(constructor) {
+    auto f = anonymous();
+    auto p = f.get();
+    wrap::memory_map g(std::move(f));
+    CHECK_EQUAL(false, f.valid());
+    CHECK_EQUAL(true, g.valid());
+    CHECK_EQUAL(p, g.get());
+    CHECK_EQUAL(length, g.size());
+  }
+
+  TEST(assignment) {
+    auto f = anonymous();
+    auto p = f.get();
+    wrap::memory_map g;
+    g = std::move(f);
+    CHECK_EQUAL(false, f.valid());
+    CHECK_EQUAL(true, g.valid());
+    CHECK_EQUAL(p, g.get());
+  }
+
+}
@@ -0,0 +1,251 @@
+//
+// Copyright (c) 2026
+// Kyle Markley.  All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+// 3. Neither the name of the author nor the names of any contributors may be
+//    used to endorse or promote products derived from this software without
+//    specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include "arr/parallel_directory_traversal.hpp"
+#include "arr/fcntl.hpp"
+#include <algorithm>
+#include <thread>
+#include <utility>
+
+namespace arr {
+
+parallel_directory_traversal::parallel_directory_traversal(
+    std::string directory,
+    unsigned threads,
+    visit_type visit,
+    directory_options options)
+  : _root(std::move(directory))
+  , _threads(threads ? threads : std::max(1u, std::thread::hardware_concurrency()))
+  , _visit(visit)
+  , _options(options)
+{
+}
+
+parallel_directory_traversal::~parallel_directory_traversal() {
+  for (auto& d : _deques) {
+    while (auto t = d->pop()) delete *t;
+  }
+}
+
+void parallel_directory_traversal::run(visitor_type visitor,
+    exit_visitor_type leave) {
+  _visitor = std::move(visitor);
+  _leave = std::move(leave);
+  _stop.store(false, std::memory_order::relaxed);
+  _failure = nullptr;
+  _deques.clear();
+  for (unsigned i = 0; i < _threads; ++i) {
+    _deques.emplace_back(new deque_type());
+  }
+  _pending.store(1u, std::memory_order::relaxed);
+  _deques.front()->push(new task{nullptr, _root, _root, nullptr});
+
+  std::vector<std::thread> helpers;
+  helpers.reserve(_threads - 1u);
+  for (unsigned i = 1; i < _threads; ++i) {
+    helpers.emplace_back([this, i] { work(i); });
+  }
+  work(0u);
+  for (auto& h : helpers) h.join();
+  if (_failure) std::rethrow_exception(_failure);
+}
+
+void parallel_directory_traversal::work(unsigned worker) {
+  using enum std::memory_order;
+  auto execute = [&](task * t) {
+    {
+      std::unique_ptr<task> owned(t);
+      if (not _stop.load(relaxed)) process(worker, *owned);
+    }
+    finish_task();
+  };
+  for (;;) {
+    if (auto t = find_task(worker)) {
+      execute(t);
+      continue;
+    }
+    if (0u == _pending.load(acquire)) return;
+    //
+    // Sleep until a task is pushed or the traversal ends.  The sleeper count
+    // is raised before looking again, and pushers look at it after pushing,
+    // so either the pusher wakes us or we find its task.
+    //
+    auto epoch = _epoch.load(acquire);
+    _sleepers.fetch_add(1u, seq_cst);
+    if (auto t = find_task(worker)) {
+      _sleepers.fetch_sub(1u, relaxed);
+      execute(t);
+      continue;
+    }
+    if (0u != _pending.load(seq_cst)) _epoch.wait(epoch, acquire);
+    _sleepers.fetch_sub(1u, relaxed);
+  }
+}
+
+void parallel_directory_traversal::process(unsigned worker, task& t) {
+  std::list<std::unique_ptr<syscall_exception>> errors;
+  std::shared_ptr<directory_node> node;
+  if (_leave) {
+    node = std::make_shared<directory_node>();
+    node->up = std::move(t.up);
+    node->parent = t.parent;
+    node->name = t.name;
+    node->path = t.path;
+  }
+  try {
+    directory_sequence ds(
+        t.parent ? t.parent->get() : AT_FDCWD, t.name, t.path, _options);
+    std::shared_ptr<wrap::file_descriptor> self;
+    bool by_path = false;
+    for (auto i = ds.begin(); i != ds.end(); ++i) {
+      i.type();         // Resolve DT_UNKNOWN
+      parallel_directory_entry e{ds, *i, i.dir_fd(), worker, true};
+      if (visits(*i)) {
+        try {
+          _visitor(e);
+        } catch (...) {
+          fail(std::current_exception());
+          break;
+        }
+      }
+      if (DT_DIR == i->d_type and e.descend) {
+        auto path = ds.path() + i->d_name;
+        if (not self and not by_path) {
+          // Keep this directory open for its queued subdirectories, or if
+          // out of descriptors, open them by path instead
+          try {
+            self = std::make_shared<wrap::file_descriptor>(
+                wrap::openat(SOURCE_CONTEXT, i.dir_fd(), ".",
+                  O_RDONLY|O_DIRECTORY|O_CLOEXEC, 0));
+          } catch (syscall_exception&) {
+            by_path = true;
+          }
+        }
+        if (node) node->remaining.fetch_add(1u, std::memory_order::relaxed);
+        try {
+          if (self) {
+            push(worker, new task{self, i->d_name, std::move(path), node});
+          } else {
+            push(worker, new task{nullptr, path, path, node});
+          }
+        } catch (...) {
+          if (node) node->remaining.fetch_sub(1u, std::memory_order::relaxed);
+          throw;
+        }
+      }
+      if (_stop.load(std::memory_order::relaxed)) break;
+    }
+    errors.splice(errors.end(), ds.exceptions);
+  } catch (syscall_exception& e) {
+    errors.emplace_back(e.clone());
+  } catch (...) {
+    fail(std::current_exception());
+  }
+  if (not errors.empty()) {
+    std::lock_guard<std::mutex> guard(_lock);
+    exceptions.splice(exceptions.end(), errors);
+  }
+  if (node) leave(worker, std::move(node));
+}
+
+void parallel_directory_traversal::push(unsigned worker, task * t) {
+  using enum std::memory_order;
+  _pending.fetch_add(1u, relaxed);
+  try {
+    _deques[worker]->push(t);
+  } catch (...) {
+    delete t;
+    _pending.fetch_sub(1u, relaxed);
+    throw;
+  }
+  std::atomic_thread_fence(seq_cst);
+  if (_sleepers.load(relaxed)) {
+    _epoch.fetch_add(1u, release);
+    _epoch.notify_all();
+  }
+}
+
+parallel_directory_traversal::task *
+parallel_directory_traversal::find_task(unsigned worker) {
+  if (auto t = _deques[worker]->pop()) return *t;
+  for (unsigned n = 1; n < _threads; ++n) {
+    auto victim = (worker + n) % _threads;
+    if (auto t = _deques[victim]->steal()) return *t;
+  }
+  return nullptr;
+}
+
+void parallel_directory_traversal::finish_task() noexcept {
+  if (1u == _pending.fetch_sub(1u, std::memory_order::acq_rel)) {
+    _epoch.fetch_add(1u, std::memory_order::release);
+    _epoch.notify_all();
+  }
+}
+
+void parallel_directory_traversal::leave(unsigned worker,
+    std::shared_ptr<directory_node> node) noexcept {
+  //
+  // The worker finishing the last part of a subtree leaves its directory,
+  // and then continues with the parent.
+  //
+  while (node and 1u == node->remaining.fetch_sub(1u,
+        std::memory_order::acq_rel)) {
+    if (not _stop.load(std::memory_order::relaxed)) {
+      int fd = node->parent ? node->parent->get() : AT_FDCWD;
+      try {
+        _leave(parallel_directory_exit{fd, node->name, node->path, worker});
+      } catch (...) {
+        fail(std::current_exception());
+      }
+    }
+    node = std::move(node->up);
+  }
+}
+
+void parallel_directory_traversal::fail(std::exception_ptr e) noexcept {
+  {
+    std::lock_guard<std::mutex> guard(_lock);
+    if (not _failure) _failure = e;
+  }
+  _stop.store(true, std::memory_order::relaxed);
+}
+
+bool parallel_directory_traversal::visits(
+    const struct dirent& entry) const noexcept {
+  switch (_visit) {
+    case visit_type::all:       return true;
+    case visit_type::directory: return DT_DIR == entry.d_type;
+    case visit_type::file:      return DT_REG == entry.d_type;
+    case visit_type::link:      return DT_LNK == entry.d_type;
+    case visit_type::non_dir:   return DT_DIR != entry.d_type;
+  }
+  return true;
+}
+
+}
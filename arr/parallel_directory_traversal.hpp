@@ -0,0 +1,200 @@
+#ifndef ARR_PARALLEL_DIRECTORY_TRAVERSAL_HPP
+#define ARR_PARALLEL_DIRECTORY_TRAVERSAL_HPP
+//
+// Copyright (c) 2026
+// Kyle Markley.  All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+// 3. Neither the name of the author nor the names of any contributors may be
+//    used to endorse or promote products derived from this software without
+//    specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include "arr/file_descriptor.hpp"
+#include "arr/recursive_directory_sequence.hpp"
+#include "arr/work_stealing_deque.hpp"
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace arr {
+
+/// \addtogroup directory_traversal
+/// @{
+
+///
+/// Entry visited by a parallel_directory_traversal
+///
+struct parallel_directory_entry {
+  const directory_sequence& directory;  ///< Directory containing the entry
+  const struct dirent& entry;           ///< The entry
+  int dir_fd;                           ///< Descriptor of \c directory
+  unsigned worker;                      ///< Index of the visiting thread
+  mutable bool descend;                 ///< Whether a directory will be
+                                        ///< descended into; the visitor may
+                                        ///< clear it to prune the directory
+
+  /// Path of the entry
+  std::string path() const { return directory.path() + entry.d_name; }
+};
+
+///
+/// Directory left by a parallel_directory_traversal
+///
+/// The directory is named relative to a descriptor of its parent, so that
+/// it may be operated upon, for example with unlinkat, without resolving its
+/// path.
+///
+struct parallel_directory_exit {
+  int parent_fd;                        ///< Descriptor of the parent, or
+                                        ///< AT_FDCWD
+  const std::string& name;              ///< Name relative to \c parent_fd
+  const std::string& path;              ///< Path of the directory
+  unsigned worker;                      ///< Index of the calling thread
+};
+
+///
+/// Recursive directory traversal by several threads
+///
+/// Each directory is read by one worker thread, which visits its entries and
+/// queues its subdirectories in a work-stealing deque.  A worker takes the
+/// most recently queued subdirectory from its own deque, and an idle worker
+/// steals the least recently queued subdirectory of another, so the
+/// traversal is depth-first within a worker and spreads over the tree as
+/// workers become idle.
+///
+/// Subdirectories are opened relative to a descriptor of their parent, which
+/// is kept open only while some of its subdirectories are still queued.
+///
+/// There is no ordering between entries of different directories.  The
+/// visitor is called concurrently from all workers, and must synchronize any
+/// shared state.  If the visitor throws, the traversal stops and \c run
+/// rethrows the first exception.
+///
+struct parallel_directory_traversal {
+  using visit_type = recursive_directory_sequence::visit_type;
+  using visitor_type = std::function<void(const parallel_directory_entry&)>;
+  using exit_visitor_type =
+    std::function<void(const parallel_directory_exit&)>;
+
+  ///
+  /// Construct a parallel_directory_traversal
+  ///
+  /// @param directory Root of the traversal
+  /// @param threads   Number of worker threads (0 for the number of CPUs)
+  /// @param visit     Type of entries to visit
+  /// @param options   Options for reading each directory
+  ///
+  parallel_directory_traversal(
+      std::string directory,
+      unsigned threads = 0u,
+      visit_type visit = visit_type::all,
+      directory_options options = {});
+
+  parallel_directory_traversal(const parallel_directory_traversal& ) = delete;
+  parallel_directory_traversal(      parallel_directory_traversal&&) = delete;
+  parallel_directory_traversal& operator=(const parallel_directory_traversal& ) = delete;
+  parallel_directory_traversal& operator=(      parallel_directory_traversal&&) = delete;
+  ~parallel_directory_traversal();
+
+  ///
+  /// Visit every entry below the root
+  ///
+  /// @param visitor Called as \c visitor(entry) for each entry
+  /// @param leave   If given, called as \c leave(exit) for each directory
+  ///                read, including the root, once its entries have been
+  ///                visited and every subdirectory has been left
+  ///
+  /// The calling thread is one of the workers.  Directories are left in
+  /// parallel, each by the worker that finishes the last of its subtree, so
+  /// \c leave is a post-order visit.  A directory whose subtree was not
+  /// finished, because the traversal stopped, is not left.
+  ///
+  /// While leaving is requested, the descriptor of each directory is kept
+  /// open until its subdirectories have been left.
+  ///
+  void run(visitor_type visitor, exit_visitor_type leave = nullptr);
+
+  const std::string& root() const noexcept { return _root; }
+  unsigned threads() const noexcept { return _threads; }
+
+  ///
+  /// Exceptions encountered during directory traversal
+  ///
+  std::list<std::unique_ptr<syscall_exception>> exceptions;
+
+private:
+
+  /// Directory read, whose subdirectories are not all left
+  struct directory_node {
+    std::shared_ptr<directory_node> up;            ///< Null for the root
+    std::shared_ptr<wrap::file_descriptor> parent; ///< Null if by path
+    std::string name;
+    std::string path;
+    std::atomic<std::size_t> remaining {1u};       ///< Itself, and its
+                                                   ///< subdirectories
+  };
+
+  /// Directory waiting to be read
+  struct task {
+    std::shared_ptr<wrap::file_descriptor> parent; ///< Null for the root
+    std::string name;
+    std::string path;
+    std::shared_ptr<directory_node> up;            ///< If leaving
+  };
+  using deque_type = work_stealing_deque<task *>;
+
+  void work(unsigned worker);
+  void process(unsigned worker, task& t);
+  void push(unsigned worker, task * t);
+  task * find_task(unsigned worker);
+  void finish_task() noexcept;
+  void leave(unsigned worker, std::shared_ptr<directory_node> node) noexcept;
+  void fail(std::exception_ptr e) noexcept;
+  bool visits(const struct dirent& entry) const noexcept;
+
+  std::string _root;
+  unsigned _threads;
+  visit_type _visit;
+  directory_options _options;
+  visitor_type _visitor;
+  exit_visitor_type _leave;
+  std::vector<std::unique_ptr<deque_type>> _deques;
+  alignas(64) std::atomic<std::size_t> _pending {0u}; ///< Tasks not finished
+  alignas(64) std::atomic<std::uint64_t> _epoch {0u}; ///< Wakes idle workers
+  std::atomic<unsigned> _sleepers {0u};
+  std::atomic<bool> _stop {false};
+  std::mutex _lock;                     ///< Guards exceptions and _failure
+  std::exception_ptr _failure;
+};
+
+/// @}
+
+}
+
+#endif
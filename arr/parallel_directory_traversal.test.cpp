@@ -0,0 +1,238 @@
+//
+// Copyright (c) 2026
+// Kyle Markley.  All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+// 3. Neither the name of the author nor the names of any contributors may be
+//    used to endorse or promote products derived from this software without
+//    specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include "arrtest/arrtest.hpp"
+#include "arr/parallel_directory_traversal.hpp"
+#include "arr/fcntl.hpp"
+#include "arr/file_descriptor.hpp"
+#include "arr/path_exception.hpp"
+#include "arr/temp_dir.hpp"
+#include <algorithm>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+UNIT_TEST_MAIN
+
+using namespace arr;
+using namespace std;
+
+namespace {
+
+// Directories d0..d3, each with files f0..f3 and subdirectories s0..s1,
+// each of which has files f0..f1
+void build_tree(const string& root) {
+  for (int d = 0; d < 4; ++d) {
+    auto dir = root + "/d" + to_string(d);
+    wrap::mkdir(SOURCE_CONTEXT, dir.c_str(), 0700);
+    for (int f = 0; f < 4; ++f) {
+      auto file = dir + "/f" + to_string(f);
+      wrap::file_descriptor fd = wrap::open(SOURCE_CONTEXT,
+          file.c_str(), O_WRONLY|O_CREAT, 0600);
+    }
+    for (int s = 0; s < 2; ++s) {
+      auto sub = dir + "/s" + to_string(s);
+      wrap::mkdir(SOURCE_CONTEXT, sub.c_str(), 0700);
+      for (int f = 0; f < 2; ++f) {
+        auto file = sub + "/f" + to_string(f);
+        wrap::file_descriptor fd = wrap::open(SOURCE_CONTEXT,
+            file.c_str(), O_WRONLY|O_CREAT, 0600);
+      }
+    }
+  }
+}
+
+set<string> serial(const string& root,
+    recursive_directory_sequence::visit_type visit) {
+  set<string> result;
+  recursive_directory_sequence rds(root,
+      recursive_directory_sequence::dir_order::pre, visit);
+  for (auto& entry : rds) result.insert(rds.path() + entry.d_name);
+  return result;
+}
+
+set<string> parallel(const string& root, unsigned threads,
+    parallel_directory_traversal::visit_type visit) {
+  set<string> result;
+  mutex lock;
+  parallel_directory_traversal pdt(root, threads, visit);
+  pdt.run([&](const parallel_directory_entry& e) {
+    lock_guard<mutex> guard(lock);
+    result.insert(e.path());
+  });
+  return result;
+}
+
+}
+
+SUITE(traversal) {
+
+  TEST(matches_serial) {
+    temp_dir t;
+    build_tree(t.name());
+    auto expected = serial(t.name(),
+        recursive_directory_sequence::visit_type::all);
+    CHECK_EQUAL(4u * (1u + 4u + 2u * (1u + 2u)), expected.size());
+    for (unsigned threads : { 1u, 2u, 4u }) {
+      auto actual = parallel(t.name(), threads,
+          parallel_directory_traversal::visit_type::all);
+      CHECK_EQUAL(true, expected == actual);
+    }
+  }
+
+  TEST(visit_type) {
+    temp_dir t;
+    build_tree(t.name());
+    using visit = recursive_directory_sequence::visit_type;
+    for (auto v : { visit::directory, visit::file, visit::non_dir }) {
+      CHECK_EQUAL(true, serial(t.name(), v) == parallel(t.name(), 3u, v));
+    }
+  }
+
+  TEST(dir_fd) {
+    temp_dir t;
+    build_tree(t.name());
+    parallel_directory_traversal pdt(t.name(), 2u,
+        parallel_directory_traversal::visit_type::file);
+    mutex lock;
+    bool ok = true;
+    pdt.run([&](const parallel_directory_entry& e) {
+      struct stat sb;
+      wrap::fstatat(SOURCE_CONTEXT, e.dir_fd, e.entry.d_name, &sb,
+          AT_SYMLINK_NOFOLLOW);
+      lock_guard<mutex> guard(lock);
+      ok = ok and S_ISREG(sb.st_mode);
+    });
+    CHECK_EQUAL(true, ok);
+  }
+
+  TEST(prune) {
+    temp_dir t;
+    build_tree(t.name());
+    parallel_directory_traversal pdt(t.name(), 2u);
+    mutex lock;
+    set<string> result;
+    pdt.run([&](const parallel_directory_entry& e) {
+      if ('s' == e.entry.d_name[0]) e.descend = false;
+      lock_guard<mutex> guard(lock);
+      result.insert(e.path());
+    });
+    CHECK_EQUAL(4u * (1u + 4u + 2u), result.size());
+  }
+
+  TEST(leave) {
+    temp_dir t;
+    build_tree(t.name());
+    auto directories = serial(t.name(),
+        recursive_directory_sequence::visit_type::directory);
+    directories.insert(t.name());
+    for (unsigned threads : { 1u, 4u }) {
+      parallel_directory_traversal pdt(t.name(), threads);
+      mutex lock;
+      set<string> visited;
+      vector<string> left;
+      bool ok = true;
+      pdt.run(
+          [&](const parallel_directory_entry& e) {
+            lock_guard<mutex> guard(lock);
+            visited.insert(e.path());
+          },
+          [&](const parallel_directory_exit& e) {
+            // The name refers to the directory relative to its parent
+            struct stat sb;
+            wrap::fstatat(SOURCE_CONTEXT, e.parent_fd, e.name.c_str(), &sb,
+                AT_SYMLINK_NOFOLLOW);
+            lock_guard<mutex> guard(lock);
+            ok = ok and S_ISDIR(sb.st_mode);
+            // Every entry below it has been visited, and every
+            // subdirectory left
+            for (auto& d : directories) {
+              if (d.size() > e.path.size() and 0 == d.compare(0,
+                    e.path.size() + 1u, e.path + '/')) {
+                ok = ok and visited.count(d) and
+                  find(left.begin(), left.end(), d) != left.end();
+              }
+            }
+            left.push_back(e.path);
+          });
+      CHECK_EQUAL(true, ok);
+      CHECK_EQUAL(directories.size(), left.size());
+      CHECK_EQUAL(true, directories == set<string>(left.begin(), left.end()));
+      CHECK_EQUAL(t.name(), left.back());
+    }
+  }
+
+}
+
+SUITE(errors) {
+
+  TEST(missing_root) {
+    temp_dir t;
+    parallel_directory_traversal pdt(string(t.name()) + "/missing", 2u);
+    unsigned visited = 0u;
+    pdt.run([&](const parallel_directory_entry&) { ++visited; });
+    CHECK_EQUAL(0u, visited);
+    CHECK_EQUAL(1u, pdt.exceptions.size());
+  }
+
+  TEST(visitor_throws) {
+    temp_dir t;
+    build_tree(t.name());
+    parallel_directory_traversal pdt(t.name(), 4u);
+    try {
+      pdt.run([](const parallel_directory_entry&) {
+        throw runtime_error("visitor");
+      });
+      CHECK_CATCH(runtime_error, e);
+      CHECK_EQUAL(string("visitor"), string(e.what()));
+    }
+  }
+
+  TEST(visitor_throws_syscall) {
+    temp_dir t;
+    build_tree(t.name());
+    parallel_directory_traversal pdt(t.name(), 4u,
+        parallel_directory_traversal::visit_type::file);
+    try {
+      pdt.run([](const parallel_directory_entry& e) {
+        // A file is not a directory, so this fails with ENOTDIR
+        auto path = e.path() + "/missing";
+        wrap::file_descriptor fd = wrap::open(SOURCE_CONTEXT,
+            path.c_str(), O_RDONLY, 0);
+      });
+      CHECK_CATCH(path_exception, e);
+      CHECK_EQUAL(true, e.code() == errc::not_a_directory);
+    }
+    CHECK_EQUAL(0u, pdt.exceptions.size());
+  }
+
+}
@@ -0,0 +1,130 @@
+//
+// Copyright (c) 2026
+// Kyle Markley.  All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+// 3. Neither the name of the author nor the names of any contributors may be
+//    used to endorse or promote products derived from this software without
+//    specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include "arr/path_match.hpp"
+#include <cstddef>
+
+namespace {
+
+constexpr char separator = '/';
+
+///
+/// Match a bracket expression against a character
+///
+/// @param p Pattern, starting after the '['
+/// @param c Character to match
+/// @param matched Whether \c c is in the set
+/// @return Length of the expression after the '[', or zero if unterminated
+///
+std::size_t match_set(std::string_view p, char c, bool& matched) noexcept {
+  std::size_t i = 0;
+  bool negate = false;
+  if (i < p.size() and ('!' == p[i] or '^' == p[i])) {
+    negate = true;
+    ++i;
+  }
+  matched = false;
+  bool first = true;
+  for (; i < p.size(); ++i, first = false) {
+    auto lo = p[i];
+    if (']' == lo and not first) {
+      matched = matched != negate;
+      return i + 1;
+    }
+    if ('\\' == lo and i + 1 < p.size()) lo = p[++i];
+    auto hi = lo;
+    if (i + 2 < p.size() and '-' == p[i+1] and ']' != p[i+2]) {
+      hi = p[i+2];
+      i += 2;
+      if ('\\' == hi and i + 1 < p.size()) hi = p[++i];
+    }
+    if (lo <= c and c <= hi) matched = true;
+  }
+  return 0;
+}
+
+bool match(std::string_view p, std::string_view s, bool start) noexcept {
+  while (not p.empty()) {
+    if (start and '*' == p[0] and p.size() >= 2 and '*' == p[1] and
+        (2 == p.size() or separator == p[2])) {
+      if (2 == p.size()) return true;
+      auto rest = p.substr(3);
+      for (;;) {
+        if (match(rest, s, true)) return true;
+        auto next = s.find(separator);
+        if (std::string_view::npos == next) return false;
+        s.remove_prefix(next + 1);
+      }
+    }
+    start = false;
+    switch (p[0]) {
+      case '*':
+        p.remove_prefix(1);
+        for (std::size_t n = 0; ; ++n) {
+          if (match(p, s.substr(n), false)) return true;
+          if (n == s.size() or separator == s[n]) return false;
+        }
+      case '?':
+        if (s.empty() or separator == s[0]) return false;
+        break;
+      case '[': {
+        if (s.empty() or separator == s[0]) return false;
+        bool matched;
+        auto length = match_set(p.substr(1), s[0], matched);
+        if (length) {
+          if (not matched) return false;
+          p.remove_prefix(length);
+          break;
+        }
+        if ('[' != s[0]) return false;  // Unterminated, so literal
+        break;
+      }
+      case '\\':
+        if (p.size() > 1) p.remove_prefix(1);
+        [[fallthrough]];
+      default:
+        if (s.empty() or p[0] != s[0]) return false;
+        start = separator == p[0];
+        break;
+    }
+    p.remove_prefix(1);
+    s.remove_prefix(1);
+  }
+  return s.empty();
+}
+
+}
+
+namespace arr {
+
+bool path_match(std::string_view pattern, std::string_view path) noexcept {
+  return match(pattern, path, true);
+}
+
+}
@@ -0,0 +1,98 @@
+//
+// Copyright (c) 2026
+// Kyle Markley.  All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+// 3. Neither the name of the author nor the names of any contributors may be
+//    used to endorse or promote products derived from this software without
+//    specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include "arrtest/arrtest.hpp"
+#include "arr/path_match.hpp"
+
+UNIT_TEST_MAIN
+
+using arr::path_match;
+
+SUITE(component) {
+
+  TEST(literal) {
+    CHECK_EQUAL(true , path_match("abc", "abc"));
+    CHECK_EQUAL(false, path_match("abc", "abcd"));
+    CHECK_EQUAL(false, path_match("abcd", "abc"));
+    CHECK_EQUAL(true , path_match("", ""));
+    CHECK_EQUAL(true , path_match("\\*", "*"));
+    CHECK_EQUAL(false, path_match("\\*", "a"));
+  }
+
+  TEST(star) {
+    CHECK_EQUAL(true , path_match("*", ""));
+    CHECK_EQUAL(true , path_match("*.cpp", "a.cpp"));
+    CHECK_EQUAL(true , path_match("*.cpp", ".cpp"));
+    CHECK_EQUAL(false, path_match("*.cpp", "a.hpp"));
+    CHECK_EQUAL(true , path_match("a*b*c", "aXbYbZc"));
+    CHECK_EQUAL(false, path_match("*", "a/b"));
+    CHECK_EQUAL(true , path_match("*/*", "a/b"));
+  }
+
+  TEST(question) {
+    CHECK_EQUAL(true , path_match("a?c", "abc"));
+    CHECK_EQUAL(false, path_match("a?c", "ac"));
+    CHECK_EQUAL(false, path_match("a?c", "a/c"));
+  }
+
+  TEST(set) {
+    CHECK_EQUAL(true , path_match("[abc]", "b"));
+    CHECK_EQUAL(false, path_match("[abc]", "d"));
+    CHECK_EQUAL(true , path_match("[a-c]x", "bx"));
+    CHECK_EQUAL(true , path_match("[!a-c]", "d"));
+    CHECK_EQUAL(false, path_match("[^a-c]", "b"));
+    CHECK_EQUAL(true , path_match("[]]", "]"));
+    CHECK_EQUAL(true , path_match("[a-]", "-"));
+    CHECK_EQUAL(true , path_match("[ab", "[ab"));
+    CHECK_EQUAL(false, path_match("[/]", "/"));
+  }
+
+}
+
+SUITE(components) {
+
+  TEST(double_star) {
+    CHECK_EQUAL(true , path_match("**", "a/b/c"));
+    CHECK_EQUAL(true , path_match("**/c", "c"));
+    CHECK_EQUAL(true , path_match("**/c", "a/b/c"));
+    CHECK_EQUAL(false, path_match("**/c", "a/bc"));
+    CHECK_EQUAL(true , path_match("a/**/c", "a/c"));
+    CHECK_EQUAL(true , path_match("a/**/c", "a/x/y/c"));
+    CHECK_EQUAL(false, path_match("a/**/c", "b/x/c"));
+    CHECK_EQUAL(true , path_match("a/**", "a/x/y"));
+    CHECK_EQUAL(true , path_match("**/*.o", "x/y/z.o"));
+  }
+
+  TEST(not_a_component) {
+    CHECK_EQUAL(true , path_match("a**", "abc"));
+    CHECK_EQUAL(false, path_match("a**", "ab/c"));
+    CHECK_EQUAL(false, path_match("**b", "a/b"));
+  }
+
+}
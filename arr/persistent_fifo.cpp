@@ -0,0 +1,143 @@
+//
+// Copyright (c) 2026
+// Kyle Markley.  All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+// 3. Neither the name of the author nor the names of any contributors may be
+//    used to endorse or promote products derived from this software without
+//    specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include "arr/persistent_fifo.hpp"
+#include "arr/fcntl.hpp"
+#include "arr/mman.hpp"
+#include "arr/path_exception.hpp"
+#include "arr/unistd.hpp"
+#include <sys/file.h>
+#include <cerrno>
+#include <cstdint>
+#include <limits>
+
+namespace arr {
+
+static_assert(std::atomic<persistent_fifo_header::size_type>::is_always_lock_free,
+    "persistent_fifo totals must be lock-free to be shared through a file");
+
+namespace {
+
+std::size_t page_size() {
+  static const auto size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+  return size;
+}
+
+std::size_t round_up(std::size_t n, std::size_t multiple) {
+  return (n + multiple - 1u) / multiple * multiple;
+}
+
+}
+
+persistent_fifo_base::persistent_fifo_base(
+    const char * path,
+    std::size_t element_size,
+    size_type count,
+    persistence durability)
+  : _path(path)
+  , _durability(durability)
+  , _fd(wrap::open(SOURCE_CONTEXT, path, O_RDWR|O_CREAT|O_CLOEXEC, 0600))
+  , _header(nullptr)
+  , _data(nullptr)
+{
+  auto invalid = [&] {
+    return path_exception(SOURCE_CONTEXT, __func__, _path, EINVAL);
+  };
+  const auto data_offset = round_up(sizeof(persistent_fifo_header), 64u);
+  // Extent of the elements after the header, if it fits in a size_t
+  auto extent = [&](std::size_t capacity, std::size_t& length) {
+    return not __builtin_mul_overflow(capacity, element_size, &length)
+      and not __builtin_add_overflow(length, data_offset, &length);
+  };
+
+  // Only one process may use the file
+  if (0 != ::flock(_fd.get(), LOCK_EX|LOCK_NB)) {
+    throw path_exception(SOURCE_CONTEXT, "flock", _path);
+  }
+
+  struct stat sb;
+  wrap::fstat(SOURCE_CONTEXT, _fd.get(), &sb);
+  bool create = 0 == sb.st_size;
+  std::size_t length;
+  if (create) {
+    if (0u == count or 0u == element_size or
+        element_size > std::numeric_limits<std::uint32_t>::max() or
+        not extent(count, length) or
+        length > std::size_t(std::numeric_limits<off_t>::max())) {
+      throw invalid();
+    }
+    wrap::ftruncate(SOURCE_CONTEXT, _fd.get(), static_cast<off_t>(length));
+  } else {
+    length = static_cast<std::size_t>(sb.st_size);
+    if (length < data_offset) throw invalid();
+  }
+
+  _map = wrap::memory_map(wrap::mmap(SOURCE_CONTEXT, nullptr, length,
+        PROT_READ|PROT_WRITE, MAP_SHARED, _fd.get(), 0), length);
+  _header = static_cast<persistent_fifo_header *>(_map.get());
+  _data = static_cast<std::byte *>(_map.get()) + data_offset;
+  auto& h = *_header;
+
+  if (create) {
+    // The magic is written last, so a partially created file is rejected
+    h.version = persistent_fifo_header::version_value;
+    h.element_size = static_cast<std::uint32_t>(element_size);
+    h.capacity = count;
+    h.data_offset = data_offset;
+    h.read_total.store(0u, std::memory_order::relaxed);
+    h.write_total.store(0u, std::memory_order::relaxed);
+    sync(_map.get(), data_offset);
+    std::memcpy(h.magic, persistent_fifo_header::magic_value, sizeof(h.magic));
+    sync(_map.get(), data_offset);
+  } else {
+    auto r = h.read_total.load(std::memory_order::acquire);
+    auto w = h.write_total.load(std::memory_order::acquire);
+    std::size_t needed;
+    bool valid = 0 == std::memcmp(
+        h.magic, persistent_fifo_header::magic_value, sizeof(h.magic))
+      and h.version == persistent_fifo_header::version_value
+      and h.element_size == element_size
+      and h.data_offset == data_offset
+      and 0u != h.capacity
+      and extent(h.capacity, needed) and length >= needed
+      and r <= w and w - r <= h.capacity;
+    if (not valid) throw invalid();
+  }
+}
+
+void persistent_fifo_base::sync(const void * address, std::size_t length) {
+  if (persistence::system != _durability or 0u == length) return;
+  auto begin = reinterpret_cast<std::uintptr_t>(address);
+  auto first = begin / page_size() * page_size();
+  auto last = round_up(begin + length, page_size());
+  wrap::msync(SOURCE_CONTEXT,
+      reinterpret_cast<void *>(first), last - first, MS_SYNC);
+}
+
+}
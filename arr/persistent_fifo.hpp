@@ -0,0 +1,340 @@
+#ifndef ARR_PERSISTENT_FIFO_HPP
+#define ARR_PERSISTENT_FIFO_HPP
+//
+// Copyright (c) 2026
+// Kyle Markley.  All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+// 3. Neither the name of the author nor the names of any contributors may be
+//    used to endorse or promote products derived from this software without
+//    specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include "arr/buffer_direction.hpp"
+#include "arr/file_descriptor.hpp"
+#include "arr/memory_map.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+namespace arr {
+
+///
+/// \ingroup buffers
+/// Durability of a persistent_fifo
+///
+enum class persistence {
+  process,      ///< Survives termination of the process
+  system,       ///< Survives failure of the system (synchronous msync)
+};
+
+///
+/// \ingroup buffers
+/// Layout of the file backing a persistent_fifo
+///
+/// The totals are updated only after the elements they cover, so a reopened
+/// file never exposes an element that was not completely written.
+///
+struct persistent_fifo_header {
+  using size_type = std::uint64_t;
+  static constexpr char magic_value[8] = "arrfifo";
+  static constexpr std::uint32_t version_value = 1u;
+
+  char          magic[8];
+  std::uint32_t version;
+  std::uint32_t element_size;
+  size_type     capacity;
+  size_type     data_offset;
+  alignas(64) std::atomic<size_type> read_total;
+  alignas(64) std::atomic<size_type> write_total;
+};
+
+///
+/// \ingroup buffers
+/// Untyped storage of a persistent_fifo
+///
+struct persistent_fifo_base {
+  using size_type = persistent_fifo_header::size_type;
+
+  ///
+  /// Open or create the backing file
+  ///
+  /// @param path         File name
+  /// @param element_size Size of each element
+  /// @param count        Capacity, used only when creating the file
+  /// @param durability   Durability of transferred elements
+  ///
+  /// A file created by another process is validated before use; a mismatched
+  /// element size or inconsistent totals throw \c path_exception (EINVAL),
+  /// as does a capacity whose file size would overflow.  The file is locked
+  /// with flock(2); if another process holds it, \c path_exception
+  /// (EWOULDBLOCK) is thrown.
+  ///
+  persistent_fifo_base(
+      const char * path,
+      std::size_t element_size,
+      size_type count,
+      persistence durability);
+
+  persistent_fifo_base(const persistent_fifo_base& ) = delete;
+  persistent_fifo_base(      persistent_fifo_base&&) = delete;
+  persistent_fifo_base& operator=(const persistent_fifo_base& ) = delete;
+  persistent_fifo_base& operator=(      persistent_fifo_base&&) = delete;
+
+  const std::string& path() const noexcept { return _path; }
+  persistence durability() const noexcept { return _durability; }
+
+protected:
+
+  /// Make a range of the mapping durable, if required by the durability
+  void sync(const void * address, std::size_t length);
+
+  persistent_fifo_header& header() const noexcept { return *_header; }
+  void * data() const noexcept { return _data; }
+
+private:
+  std::string _path;
+  persistence _durability;
+  wrap::file_descriptor _fd;
+  wrap::memory_map _map;
+  persistent_fifo_header * _header;
+  std::byte * _data;
+};
+
+///
+/// \ingroup buffers
+/// First-In First-Out buffer of elements, stored in a memory-mapped file
+///
+/// The elements and the read and write totals live in a file mapped with
+/// \c MAP_SHARED, so a queue outlives the process using it: after a restart
+/// the file is reopened and the elements still in it are read as usual.
+///
+/// Each transfer copies elements to or from the mapping and then publishes
+/// the new total with a release store.  With \c persistence::system the
+/// element range is flushed with a synchronous msync before the total is
+/// published, and the total is flushed afterward, so the file is consistent
+/// after a system failure at any point.
+///
+/// \par Concurrency
+///
+/// As with \c fifo, one reader thread and one writer thread may operate
+/// concurrently.  Only one process may use a file at a time, which is
+/// enforced by an exclusive flock(2) held while the queue is open.
+///
+/// \par Elements
+///
+/// Elements are stored as raw bytes, so they must be trivially copyable, and
+/// must not refer to memory of the process that wrote them.
+///
+template <typename T>
+struct persistent_fifo : persistent_fifo_base {
+  static_assert(std::is_trivially_copyable<T>::value,
+      "persistent_fifo elements must be trivially copyable");
+  static_assert(alignof(T) <= 64u,
+      "persistent_fifo elements are stored at a 64-byte aligned offset");
+  using value_type = T;
+  using size_type = persistent_fifo_base::size_type;
+  using direction_data = buffer_direction<size_type>;
+
+  ///
+  /// Open or create a persistent_fifo
+  ///
+  /// @param path       File name
+  /// @param count      Capacity, used only when creating the file
+  /// @param durability Durability of transferred elements
+  /// @param policy     Wake policy for waiting threads
+  ///
+  persistent_fifo(
+      const char * path,
+      size_type count,
+      persistence durability = persistence::process,
+      wake_policy policy = wake_policy::all)
+    : persistent_fifo_base(path, sizeof(T), count, durability)
+    , _policy(policy)
+    , _capacity(header().capacity)
+    , _elements(static_cast<T *>(data()))
+    , _read (header(). read_total.load(std::memory_order::acquire), _capacity)
+    , _write(header().write_total.load(std::memory_order::acquire), _capacity)
+  { }
+
+  auto  read_total() const noexcept { return  _read.total(); }
+  auto write_total() const noexcept { return _write.total(); }
+  void wait_for_write(size_type old,
+      std::memory_order order = std::memory_order::seq_cst) noexcept {
+    _write.wait(old, order);
+  }
+  void wait_for_write(
+      std::memory_order order = std::memory_order::seq_cst) noexcept {
+    wait_for_write(read_total(), order);
+  }
+  void wait_for_read(size_type old,
+      std::memory_order order = std::memory_order::seq_cst) noexcept {
+    _read.wait(old, order);
+  }
+  void wait_for_read(
+      std::memory_order order = std::memory_order::seq_cst) noexcept {
+    wait_for_read(write_total() - capacity(), order);
+  }
+
+  ///
+  /// @name Capacity
+  /// @{
+  ///
+  bool      empty() const noexcept { return size() == 0; }
+  bool       full() const noexcept { return size() == capacity(); }
+  size_type  size() const noexcept { return write_total() - read_total(); }
+  size_type capacity() const noexcept { return _capacity; }
+  /// @}
+
+  ///
+  /// @name Element access
+  /// @{
+  ///
+  /// It is undefined behavior to access the front element of an empty fifo.
+  ///
+  value_type front() const noexcept {
+    value_type value;
+    std::memcpy(&value, _elements + _read.offset(), sizeof(T));
+    return value;
+  }
+  /// @}
+
+  ///
+  /// @name Modifiers
+  /// @{
+  ///
+  /// It is undefined behavior to pop from an empty fifo, or to push onto a
+  /// full fifo.
+  ///
+  void clear() { discard(size()); }
+  void pop() { discard(1u); }
+  void push(const value_type& value) { write(&value, 1u); }
+  /// @}
+
+  /// Number of elements transferred by the last \c discard or \c read
+  size_type  last_read_size() const noexcept { return  _read.recent(); }
+  /// Number of elements transferred by the last \c write
+  size_type last_write_size() const noexcept { return _write.recent(); }
+
+  ///
+  /// Discard elements
+  ///
+  /// @param num Number of elements to discard
+  /// @return Number of elements discarded
+  ///
+  size_type discard(size_type num) {
+    _read.reset_recent();
+    num = std::min(num, size());
+    while (num) {
+      auto n = std::min(num, _capacity - _read.offset());
+      publish_read(n);
+      num -= n;
+    }
+    return last_read_size();
+  }
+
+  ///
+  /// Read elements
+  ///
+  /// @param dst Destination of elements
+  /// @param num Number of elements to read
+  /// @return First destination position not written
+  ///
+  /// The number of elements read may be less than the number requested
+  /// if the buffer becomes empty.
+  ///
+  template <typename output_iterator>
+  output_iterator read(output_iterator dst, size_type num) {
+    _read.reset_recent();
+    num = std::min(num, size());
+    while (num) {
+      auto n = std::min(num, _capacity - _read.offset());
+      auto first = _elements + _read.offset();
+      dst = std::copy(first, first + n, dst);
+      publish_read(n);
+      num -= n;
+    }
+    return dst;
+  }
+
+  ///
+  /// Write elements
+  ///
+  /// @param src Source of elements
+  /// @param num Number of elements to write
+  /// @return First source position not read
+  ///
+  /// The number of elements written may be less than the number requested
+  /// if the buffer becomes full.  When the call returns, the elements
+  /// written are as durable as selected at construction.
+  ///
+  template <typename input_iterator>
+  input_iterator write(input_iterator src, size_type num) {
+    _write.reset_recent();
+    num = std::min(num, _capacity - size());
+    while (num) {
+      auto n = std::min(num, _capacity - _write.offset());
+      auto first = _elements + _write.offset();
+      for (size_type i = 0; i < n; ++i, ++src) first[i] = *src;
+      sync(first, n * sizeof(T));
+      publish_write(n);
+      num -= n;
+    }
+    return src;
+  }
+
+private:
+
+  ///
+  /// Make consumption of elements visible and durable
+  ///
+  /// The persisted total is updated before the in-process total, so that a
+  /// writer woken by the read never overwrites an element still counted as
+  /// unread in the file.
+  ///
+  void publish_read(size_type num) {
+    header().read_total.store(read_total() + num, std::memory_order::release);
+    sync(&header().read_total, sizeof(header().read_total));
+    _read.increase_weak(num, _capacity, _policy);
+  }
+
+  /// Make production of elements visible and durable
+  void publish_write(size_type num) {
+    header().write_total.store(write_total() + num, std::memory_order::release);
+    sync(&header().write_total, sizeof(header().write_total));
+    _write.increase_weak(num, _capacity, _policy);
+  }
+
+  wake_policy _policy;
+  size_type _capacity;
+  T * _elements;
+  alignas(64) direction_data _read;
+  alignas(64) direction_data _write;
+};
+
+}
+
+#endif
@@ -0,0 +1,192 @@
+//
+// Copyright (c) 2026
+// Kyle Markley.  All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+// 3. Neither the name of the author nor the names of any contributors may be
+//    used to endorse or promote products derived from this software without
+//    specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include "arrtest/arrtest.hpp"
+#include "arr/persistent_fifo.hpp"
+#include "arr/path_exception.hpp"
+#include "arr/temp_dir.hpp"
+#include <array>
+#include <limits>
+#include <string>
+#include <thread>
+
+UNIT_TEST_MAIN
+
+using namespace arr;
+using namespace std;
+
+namespace {
+
+string queue_name(const temp_dir& dir) {
+  return string(dir.name()) + "/queue";
+}
+
+}
+
+SUITE(basic) {
+
+  TEST(create) {
+    temp_dir dir;
+    auto file = queue_name(dir);
+    persistent_fifo<int> buf(file.c_str(), 4);
+    CHECK_EQUAL(4u, buf.capacity());
+    CHECK_EQUAL(true, buf.empty());
+    buf.push(1);
+    buf.push(2);
+    CHECK_EQUAL(2u, buf.size());
+    CHECK_EQUAL(1, buf.front());
+    buf.pop();
+    CHECK_EQUAL(2, buf.front());
+    CHECK_EQUAL(1u, buf.read_total());
+    CHECK_EQUAL(2u, buf.write_total());
+  }
+
+  TEST(wraparound) {
+    temp_dir dir;
+    auto file = queue_name(dir);
+    persistent_fifo<int> buf(file.c_str(), 4);
+    array<int, 6> i = {{ 1, 2, 3, 4, 5, 6 }};
+    array<int, 6> o = {{ 0, 0, 0, 0, 0, 0 }};
+    buf.write(i.data(), 3);
+    buf.discard(2);
+    auto src = buf.write(i.data() + 3, 3);    // Wraps the storage
+    CHECK_EQUAL(i.data() + 6, src);
+    CHECK_EQUAL(3u, buf.last_write_size());
+    CHECK_EQUAL(true, buf.full());
+    CHECK_EQUAL(0u, buf.write(i.data(), 1) - i.data());
+    auto dst = buf.read(o.data(), 6);
+    CHECK_EQUAL(4u, buf.last_read_size());
+    CHECK_EQUAL(o.data() + 4, dst);
+    CHECK_EQUAL(3, o[0]);
+    CHECK_EQUAL(6, o[3]);
+  }
+
+}
+
+SUITE(reopen) {
+
+  TEST(survives) {
+    temp_dir dir;
+    auto file = queue_name(dir);
+    array<int, 3> i = {{ 7, 8, 9 }};
+    {
+      persistent_fifo<int> buf(file.c_str(), 4);
+      buf.write(i.data(), 3);
+      buf.pop();
+    }
+    persistent_fifo<int> buf(file.c_str(), 100);   // Capacity is kept
+    CHECK_EQUAL(4u, buf.capacity());
+    CHECK_EQUAL(2u, buf.size());
+    CHECK_EQUAL(1u, buf.read_total());
+    CHECK_EQUAL(8, buf.front());
+    buf.push(10);
+    buf.push(11);
+    array<int, 4> o = {{ 0, 0, 0, 0 }};
+    buf.read(o.data(), 4);
+    CHECK_EQUAL( 8, o[0]);
+    CHECK_EQUAL( 9, o[1]);
+    CHECK_EQUAL(10, o[2]);
+    CHECK_EQUAL(11, o[3]);
+  }
+
+  TEST(system_durability) {
+    temp_dir dir;
+    auto file = queue_name(dir);
+    {
+      persistent_fifo<long> buf(file.c_str(), 8, persistence::system);
+      buf.push(42);
+    }
+    persistent_fifo<long> buf(file.c_str(), 8, persistence::system);
+    CHECK_EQUAL(42, buf.front());
+  }
+
+  TEST(element_mismatch) {
+    temp_dir dir;
+    auto file = queue_name(dir);
+    { persistent_fifo<int> buf(file.c_str(), 4); }
+    try {
+      persistent_fifo<double> buf(file.c_str(), 4);
+      CHECK_CATCH(path_exception, e);
+      CHECK_EQUAL(true, e.code() == errc::invalid_argument);
+      CHECK_EQUAL(file, e.path());
+    }
+  }
+
+  TEST(capacity_overflow) {
+    temp_dir dir;
+    auto file = queue_name(dir);
+    try {
+      persistent_fifo<std::array<char, 64>> buf(file.c_str(),
+          numeric_limits<size_t>::max() / 32u);
+      CHECK_CATCH(path_exception, e);
+      CHECK_EQUAL(true, e.code() == errc::invalid_argument);
+    }
+  }
+
+  TEST(locked) {
+    temp_dir dir;
+    auto file = queue_name(dir);
+    persistent_fifo<int> first(file.c_str(), 4);
+    try {
+      persistent_fifo<int> second(file.c_str(), 4);
+      CHECK_CATCH(path_exception, e);
+      CHECK_EQUAL(true, e.code() == errc::operation_would_block);
+      CHECK_EQUAL(file, e.path());
+    }
+  }
+
+}
+
+SUITE(concurrency) {
+
+  TEST(transfer) {
+    temp_dir dir;
+    auto file = queue_name(dir);
+    persistent_fifo<unsigned> buf(file.c_str(), 16);
+    const unsigned count = 10000u;
+    thread writer([&] {
+      for (unsigned n = 0; n < count; ) {
+        if (buf.full()) {
+          buf.wait_for_read();
+        } else {
+          buf.push(n++);
+        }
+      }
+    });
+    bool ok = true;
+    for (unsigned n = 0; n < count; ++n) {
+      while (buf.empty()) buf.wait_for_write();
+      ok = ok and n == buf.front();
+      buf.pop();
+    }
+    writer.join();
+    CHECK_EQUAL(true, ok);
+  }
+
+}
@@ -0,0 +1,162 @@
+//
+// Copyright (c) 2026
+// Kyle Markley.  All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+// 3. Neither the name of the author nor the names of any contributors may be
+//    used to endorse or promote products derived from this software without
+//    specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include "arr/pipeline.hpp"
+#include "arr/syscall_exception.hpp"
+#include <stdexcept>
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace arr {
+
+double pipeline_stage_statistics::throughput() const noexcept {
+  auto seconds = std::chrono::duration<double>(elapsed).count();
+  auto count = elements_in ? elements_in : elements_out;
+  return seconds > 0.0 ? double(count) / seconds : 0.0;
+}
+
+std::ostream& operator<<(std::ostream& o, const pipeline_stage_statistics& s) {
+  using seconds = std::chrono::duration<double>;
+  return o << s.name
+    << ": in " << s.elements_in
+    << " out " << s.elements_out
+    << " throughput " << s.throughput() << "/s"
+    << " busy " << seconds(s.busy()).count() << "s"
+    << " input_stall " << seconds(s.input_stall).count() << "s"
+    << " output_stall " << seconds(s.output_stall).count() << "s";
+}
+
+namespace {
+
+///
+/// Pin the calling thread to a CPU
+///
+/// CPU affinity is only supported on Linux; elsewhere this does nothing.
+/// Throws \c std::invalid_argument if \c cpu is beyond a \c cpu_set_t.
+///
+void pin_current_thread(int cpu) {
+#if defined(__linux__)
+  if (cpu >= CPU_SETSIZE) {
+    throw std::invalid_argument("pipeline stage CPU out of range");
+  }
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(static_cast<std::size_t>(cpu), &set);
+  auto r = ::pthread_setaffinity_np(::pthread_self(), sizeof(set), &set);
+  if (0 != r) {
+    throw syscall_exception(SOURCE_CONTEXT, "pthread_setaffinity_np", r);
+  }
+#else
+  static_cast<void>(cpu);
+#endif
+}
+
+}
+
+pipeline::~pipeline() {
+  request_stop();
+  for (auto& stage : _stages) {
+    if (stage.thread.joinable()) stage.thread.join();
+  }
+}
+
+void pipeline::claim(bool& flag, const char * what) {
+  if (flag) throw std::invalid_argument(what);
+  flag = true;
+}
+
+void pipeline::add(std::string name, pipeline_stage_options options,
+    std::function<void(stage_record&)> body) {
+  if (0u == options.batch) options.batch = 1u;
+  auto& stage = _stages.emplace_back();
+  stage.stats.name = std::move(name);
+  stage.options = options;
+  stage.body = std::move(body);
+}
+
+void pipeline::start() {
+  // The stages and their channels run once
+  if (_started) throw std::logic_error("pipeline already started");
+  for (auto& c : _channels) {
+    if (not *c.has_writer) {
+      throw std::invalid_argument("pipeline channel has no writer");
+    }
+    if (not *c.has_reader) {
+      throw std::invalid_argument("pipeline channel has no reader");
+    }
+  }
+  _started = true;
+  for (auto& stage : _stages) {
+    stage.thread = std::thread([this, &stage] { execute(stage); });
+  }
+}
+
+void pipeline::wait() {
+  for (auto& stage : _stages) {
+    if (stage.thread.joinable()) stage.thread.join();
+  }
+  if (_failure) std::rethrow_exception(_failure);
+}
+
+std::vector<pipeline_stage_statistics> pipeline::statistics() const {
+  std::vector<pipeline_stage_statistics> result;
+  result.reserve(_stages.size());
+  for (auto& stage : _stages) result.push_back(stage.stats);
+  return result;
+}
+
+void pipeline::execute(stage_record& stage) noexcept {
+  auto start = clock::now();
+  // A stage that cannot be pinned still runs, so its channels are closed
+  if (stage.options.cpu >= 0) {
+    try {
+      pin_current_thread(stage.options.cpu);
+    } catch (...) {
+      fail(std::current_exception());
+    }
+  }
+  try {
+    stage.body(stage);
+  } catch (...) {
+    fail(std::current_exception());
+  }
+  stage.stats.elapsed = clock::now() - start;
+}
+
+void pipeline::fail(std::exception_ptr e) noexcept {
+  {
+    std::lock_guard<std::mutex> lock(_failure_lock);
+    if (not _failure) _failure = e;
+  }
+  request_stop();
+}
+
+}
@@ -0,0 +1,451 @@
+#ifndef ARR_PIPELINE_HPP
+#define ARR_PIPELINE_HPP
+//
+// Copyright (c) 2026
+// Kyle Markley.  All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+// 3. Neither the name of the author nor the names of any contributors may be
+//    used to endorse or promote products derived from this software without
+//    specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include "arr/fifo.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace arr {
+
+///
+/// \ingroup buffers
+/// Throughput and stall statistics of one pipeline stage
+///
+struct pipeline_stage_statistics {
+  using count_type = std::uint64_t;
+  using duration   = std::chrono::nanoseconds;
+
+  std::string name;
+  count_type elements_in  = 0u;   ///< Elements read from the input
+  count_type elements_out = 0u;   ///< Elements written to the output
+  count_type batches_in   = 0u;   ///< Reads transferring elements
+  count_type batches_out  = 0u;   ///< Writes transferring elements
+  duration elapsed      {0};      ///< Run time of the stage
+  duration input_stall  {0};      ///< Time waiting for the input (empty)
+  duration output_stall {0};      ///< Time waiting for the output (full)
+
+  /// Time spent neither waiting for input nor for output
+  duration busy() const noexcept { return elapsed - input_stall - output_stall; }
+
+  ///
+  /// Elements processed per second
+  ///
+  /// Elements are counted at the input, except for a source, which has none.
+  ///
+  double throughput() const noexcept;
+};
+
+std::ostream& operator<<(std::ostream& o, const pipeline_stage_statistics& s);
+
+///
+/// \ingroup buffers
+/// Execution options of one pipeline stage
+///
+struct pipeline_stage_options {
+  std::size_t batch = 64u;  ///< Most elements transferred at once
+  int cpu = -1;             ///< CPU to pin the stage to, or -1 for any
+};
+
+///
+/// \ingroup buffers
+/// Connection between two pipeline stages
+///
+/// The end of the stream is sent in-band as an empty element, so that the
+/// reader is woken by the same write that it waits for.
+///
+template <typename T>
+struct pipeline_channel {
+  using value_type = T;
+  using element_type = std::optional<T>;
+  using buffer_type = fifo<element_type>;
+  using size_type = typename buffer_type::size_type;
+
+  explicit pipeline_channel(size_type count) : buffer(count) { }
+
+  buffer_type buffer;
+  bool has_reader = false;
+  bool has_writer = false;
+};
+
+template <typename T> struct pipeline_output;
+
+///
+/// \ingroup buffers
+/// Threads connected by fifos
+///
+/// A pipeline is built from channels and stages.  A source produces
+/// elements into a channel; a stage consumes elements from one channel and
+/// produces elements into another; a sink consumes elements from a channel.
+/// Every channel must have exactly one writing and one reading stage.
+///
+/// Each stage runs on its own thread, optionally pinned to a CPU.  Elements
+/// are moved through the fifos in batches.  A stage producing into a full
+/// channel waits for its reader, and a stage consuming from an empty channel
+/// first flushes its own pending output and then waits for its writer.
+///
+/// \par Shutdown
+///
+/// When a source returns, the end of its stream propagates through each
+/// following stage as that stage finishes its input.  \c request_stop asks
+/// sources to return early.  If any stage throws, the pipeline requests a
+/// stop, the throwing stage discards the rest of its input so that earlier
+/// stages are never blocked, and \c wait rethrows the first exception.
+///
+struct pipeline {
+  using clock = std::chrono::steady_clock;
+
+  pipeline() = default;
+  ~pipeline();  ///< Request a stop and wait for all stages
+  pipeline(const pipeline& ) = delete;
+  pipeline(      pipeline&&) = delete;
+  pipeline& operator=(const pipeline& ) = delete;
+  pipeline& operator=(      pipeline&&) = delete;
+
+  ///
+  /// Create a channel owned by the pipeline
+  ///
+  /// @param count Capacity of the channel's fifo
+  ///
+  template <typename T>
+  pipeline_channel<T>& make_channel(typename pipeline_channel<T>::size_type count) {
+    auto c = std::make_shared<pipeline_channel<T>>(count);
+    _channels.push_back(channel_record{c, &c->has_reader, &c->has_writer});
+    return *c;
+  }
+
+  ///
+  /// Add a stage producing elements
+  ///
+  /// @param name    Name of the stage in its statistics
+  /// @param out     Channel to write
+  /// @param f       Called once as \c f(pipeline_output<T>&)
+  /// @param options Execution options
+  ///
+  /// \c f should return when it has no more elements, or when
+  /// \c pipeline_output::stopped becomes true.
+  ///
+  template <typename T, typename F>
+  void add_source(std::string name, pipeline_channel<T>& out, F f,
+      pipeline_stage_options options = {});
+
+  ///
+  /// Add a stage transforming elements
+  ///
+  /// @param name    Name of the stage in its statistics
+  /// @param in      Channel to read
+  /// @param out     Channel to write
+  /// @param f       Called as \c f(I&,pipeline_output<O>&) for each element
+  /// @param options Execution options
+  ///
+  /// \c f may produce any number of output elements for each input element.
+  ///
+  template <typename I, typename O, typename F>
+  void add_stage(std::string name, pipeline_channel<I>& in,
+      pipeline_channel<O>& out, F f, pipeline_stage_options options = {});
+
+  ///
+  /// Add a stage consuming elements
+  ///
+  /// @param name    Name of the stage in its statistics
+  /// @param in      Channel to read
+  /// @param f       Called as \c f(I&) for each element
+  /// @param options Execution options
+  ///
+  template <typename I, typename F>
+  void add_sink(std::string name, pipeline_channel<I>& in, F f,
+      pipeline_stage_options options = {});
+
+  ///
+  /// Start all stages
+  ///
+  /// Throws \c std::invalid_argument if a channel lacks a reader or writer,
+  /// and \c std::logic_error if the pipeline was already started.
+  ///
+  void start();
+
+  /// Wait for all stages, and rethrow the first exception of any stage
+  void wait();
+
+  /// Start all stages and wait for them
+  void run() { start(); wait(); }
+
+  /// Ask sources to stop producing
+  void request_stop() noexcept { _stop.store(true, std::memory_order::release); }
+
+  /// Whether a stop was requested
+  bool stop_requested() const noexcept {
+    return _stop.load(std::memory_order::acquire);
+  }
+
+  ///
+  /// Statistics of each stage, in the order the stages were added
+  ///
+  /// The statistics are complete after \c wait returns.
+  ///
+  std::vector<pipeline_stage_statistics> statistics() const;
+
+private:
+
+  template <typename T> friend struct pipeline_output;
+
+  struct stage_record {
+    pipeline_stage_statistics stats;
+    pipeline_stage_options options;
+    std::function<void(stage_record&)> body;
+    std::thread thread;
+  };
+
+  struct channel_record {
+    std::shared_ptr<void> channel;
+    const bool * has_reader;
+    const bool * has_writer;
+  };
+
+  static void claim(bool& flag, const char * what);
+  void add(std::string name, pipeline_stage_options options,
+      std::function<void(stage_record&)> body);
+  void execute(stage_record& stage) noexcept;
+  void fail(std::exception_ptr e) noexcept;
+
+  ///
+  /// Read one batch of elements, waiting while the input is empty
+  ///
+  /// @return Number of elements read into \c batch
+  ///
+  template <typename T, typename flush_type>
+  std::size_t receive(pipeline_channel<T>& in,
+      std::vector<std::optional<T>>& batch, stage_record& stage,
+      flush_type& flush);
+
+  ///
+  /// Apply \c each to every element of the input until its end
+  ///
+  /// If \c each throws, the failure is recorded and the rest of the input
+  /// is discarded.
+  ///
+  template <typename T, typename flush_type, typename each_type>
+  void consume(pipeline_channel<T>& in, stage_record& stage,
+      flush_type&& flush, each_type&& each);
+
+  /// Discard the rest of the input after a failure
+  template <typename T> void drain(pipeline_channel<T>& in);
+
+  std::deque<stage_record> _stages;
+  std::vector<channel_record> _channels;
+  std::atomic<bool> _stop {false};
+  bool _started = false;        ///< Whether start was called
+  std::mutex _failure_lock;
+  std::exception_ptr _failure;
+};
+
+///
+/// \ingroup buffers
+/// Output of a pipeline stage
+///
+/// Elements are collected into a batch, which is written to the channel when
+/// full, when the stage waits for input, and when the stage finishes.
+///
+template <typename T>
+struct pipeline_output {
+  using value_type = T;
+
+  pipeline_output(const pipeline_output& ) = delete;
+  pipeline_output(      pipeline_output&&) = delete;
+  pipeline_output& operator=(const pipeline_output& ) = delete;
+  pipeline_output& operator=(      pipeline_output&&) = delete;
+
+  void push(const value_type&  value) { emplace(value); }
+  void push(      value_type&& value) { emplace(std::move(value)); }
+  template <typename ... Args>
+  void emplace(Args&&... args) {
+    _pending.emplace_back(std::in_place, std::forward<Args>(args)...);
+    if (_pending.size() >= _batch) flush();
+  }
+
+  /// Whether the pipeline asked sources to stop
+  bool stopped() const noexcept { return _owner.stop_requested(); }
+
+  /// Write all pending elements, waiting while the channel is full
+  void flush();
+
+private:
+  friend struct pipeline;
+
+  pipeline_output(pipeline& owner, pipeline_channel<T>& channel,
+      pipeline_stage_statistics& stats, std::size_t batch)
+    : _owner(owner), _channel(channel), _stats(stats), _batch(batch)
+  {
+    _pending.reserve(batch);
+  }
+
+  /// Write pending elements followed by the end of the stream
+  void finish() {
+    _pending.emplace_back();
+    flush();
+  }
+
+  pipeline& _owner;
+  pipeline_channel<T>& _channel;
+  pipeline_stage_statistics& _stats;
+  std::size_t _batch;
+  std::vector<std::optional<T>> _pending;
+};
+
+template <typename T>
+void pipeline_output<T>::flush() {
+  auto& buf = _channel.buffer;
+  auto b = std::make_move_iterator(_pending.begin());
+  auto e = std::make_move_iterator(_pending.end());
+  while (b != e) {
+    b = buf.write(b, e);
+    if (buf.last_write_size()) ++_stats.batches_out;
+    if (b != e) {
+      auto start = pipeline::clock::now();
+      buf.wait_for_read();
+      _stats.output_stall += pipeline::clock::now() - start;
+    }
+  }
+  auto num = _pending.size();
+  if (num and not _pending.back()) --num;  // The end of the stream
+  _stats.elements_out += num;
+  _pending.clear();
+}
+
+template <typename T, typename flush_type>
+std::size_t pipeline::receive(pipeline_channel<T>& in,
+    std::vector<std::optional<T>>& batch, stage_record& stage,
+    flush_type& flush) {
+  auto& buf = in.buffer;
+  if (buf.empty()) {
+    flush();
+    auto start = clock::now();
+    while (buf.empty()) buf.wait_for_write();
+    stage.stats.input_stall += clock::now() - start;
+  }
+  auto e = buf.read(batch.begin(), batch.size());
+  ++stage.stats.batches_in;
+  return static_cast<std::size_t>(e - batch.begin());
+}
+
+template <typename T, typename flush_type, typename each_type>
+void pipeline::consume(pipeline_channel<T>& in, stage_record& stage,
+    flush_type&& flush, each_type&& each) {
+  std::vector<std::optional<T>> batch(stage.options.batch);
+  std::size_t num = 0u;
+  std::size_t i = 0u;
+  bool end = false;
+  try {
+    while (not end) {
+      num = 0u;
+      num = receive(in, batch, stage, flush);
+      for (i = 0u; i < num and not end; ++i) {
+        if (batch[i]) {
+          ++stage.stats.elements_in;
+          each(*batch[i]);
+        } else {
+          end = true;
+        }
+      }
+    }
+  } catch (...) {
+    fail(std::current_exception());
+    // The end of the stream may already be in this batch
+    for (++i; i < num and not end; ++i) end = not batch[i];
+    if (not end) drain(in);
+  }
+}
+
+template <typename T>
+void pipeline::drain(pipeline_channel<T>& in) {
+  auto& buf = in.buffer;
+  for (;;) {
+    while (buf.empty()) buf.wait_for_write();
+    bool end = not buf.front();
+    buf.pop();
+    if (end) return;
+  }
+}
+
+template <typename T, typename F>
+void pipeline::add_source(std::string name, pipeline_channel<T>& out, F f,
+    pipeline_stage_options options) {
+  claim(out.has_writer, "pipeline channel already has a writer");
+  add(std::move(name), options,
+      [this, &out, f = std::move(f)](stage_record& stage) mutable {
+        pipeline_output<T> o(*this, out, stage.stats, stage.options.batch);
+        try {
+          f(o);
+        } catch (...) {
+          fail(std::current_exception());
+        }
+        o.finish();
+      });
+}
+
+template <typename I, typename O, typename F>
+void pipeline::add_stage(std::string name, pipeline_channel<I>& in,
+    pipeline_channel<O>& out, F f, pipeline_stage_options options) {
+  claim(in.has_reader, "pipeline channel already has a reader");
+  claim(out.has_writer, "pipeline channel already has a writer");
+  add(std::move(name), options,
+      [this, &in, &out, f = std::move(f)](stage_record& stage) mutable {
+        pipeline_output<O> o(*this, out, stage.stats, stage.options.batch);
+        consume(in, stage, [&] { o.flush(); }, [&](I& x) { f(x, o); });
+        o.finish();
+      });
+}
+
+template <typename I, typename F>
+void pipeline::add_sink(std::string name, pipeline_channel<I>& in, F f,
+    pipeline_stage_options options) {
+  claim(in.has_reader, "pipeline channel already has a reader");
+  add(std::move(name), options,
+      [this, &in, f = std::move(f)](stage_record& stage) mutable {
+        consume(in, stage, [] { }, [&](I& x) { f(x); });
+      });
+}
+
+}
+
+#endif
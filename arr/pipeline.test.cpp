@@ -0,0 +1,200 @@
+//
+// Copyright (c) 2026
+// Kyle Markley.  All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+// 3. Neither the name of the author nor the names of any contributors may be
+//    used to endorse or promote products derived from this software without
+//    specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include "arrtest/arrtest.hpp"
+#include "arr/pipeline.hpp"
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+UNIT_TEST_MAIN
+
+using namespace arr;
+using namespace std;
+
+SUITE(flow) {
+
+  TEST(three_stages) {
+    pipeline p;
+    auto& numbers = p.make_channel<unsigned>(16);
+    auto& strings = p.make_channel<string>(16);
+    const unsigned count = 10000u;
+    p.add_source("generate", numbers, [&](pipeline_output<unsigned>& out) {
+      for (unsigned i = 0; i < count; ++i) out.push(i);
+    });
+    p.add_stage("format", numbers, strings,
+        [](unsigned& n, pipeline_output<string>& out) {
+          if (n % 2u) out.push(to_string(n));
+        }, {.batch = 8u});
+    vector<string> result;
+    p.add_sink("collect", strings, [&](string& s) {
+      result.push_back(move(s));
+    });
+    p.run();
+    CHECK_EQUAL(count / 2u, result.size());
+    bool ordered = true;
+    for (size_t i = 0; i < result.size(); ++i) {
+      ordered = ordered and result[i] == to_string(2u * i + 1u);
+    }
+    CHECK_EQUAL(true, ordered);
+    auto stats = p.statistics();
+    CHECK_EQUAL(3u, stats.size());
+    CHECK_EQUAL(string("format"), stats[1].name);
+    CHECK_EQUAL(count, stats[0].elements_out);
+    CHECK_EQUAL(count, stats[1].elements_in);
+    CHECK_EQUAL(count / 2u, stats[1].elements_out);
+    CHECK_EQUAL(count / 2u, stats[2].elements_in);
+    for (auto& s : stats) cout << s << '\n';
+  }
+
+  TEST(pinned) {
+    pipeline p;
+    auto& c = p.make_channel<int>(4);
+    p.add_source("one", c, [](auto& out) { out.push(1); }, {.cpu = 0});
+    int total = 0;
+    p.add_sink("sum", c, [&](int& n) { total += n; });
+    p.run();
+    CHECK_EQUAL(1, total);
+  }
+
+#if defined(__linux__)
+  TEST(cpu_out_of_range) {
+    pipeline p;
+    auto& c = p.make_channel<int>(4);
+    p.add_source("one", c, [](auto& out) { out.push(1); }, {.cpu = 1 << 20});
+    p.add_sink("none", c, [](int&) { });
+    try {
+      p.run();
+      CHECK_CATCH(invalid_argument, e);
+      static_cast<void>(e);
+    }
+  }
+#endif
+
+}
+
+SUITE(shutdown) {
+
+  TEST(request_stop) {
+    pipeline p;
+    auto& c = p.make_channel<int>(4);
+    p.add_source("endless", c, [](pipeline_output<int>& out) {
+      while (not out.stopped()) out.push(0);
+    });
+    size_t seen = 0u;
+    p.add_sink("count", c, [&](int&) {
+      if (++seen == 100u) p.request_stop();
+    });
+    p.run();
+    CHECK_EQUAL(true, seen >= 100u);
+  }
+
+  TEST(sink_failure) {
+    pipeline p;
+    auto& c = p.make_channel<int>(2);
+    p.add_source("finite", c, [](pipeline_output<int>& out) {
+      for (int i = 0; i < 1000; ++i) out.push(i);
+    });
+    p.add_sink("throw", c, [](int& n) {
+      if (n == 10) throw runtime_error("sink failure");
+    });
+    try {
+      p.run();
+      CHECK_CATCH(runtime_error, e);
+      CHECK_EQUAL(string("sink failure"), string(e.what()));
+    }
+  }
+
+  TEST(source_failure) {
+    pipeline p;
+    auto& a = p.make_channel<int>(2);
+    auto& b = p.make_channel<int>(2);
+    p.add_source("throw", a, [](pipeline_output<int>& out) {
+      out.push(1);
+      throw runtime_error("source failure");
+    });
+    p.add_stage("copy", a, b, [](int& n, auto& out) { out.push(n); });
+    int total = 0;
+    p.add_sink("sum", b, [&](int& n) { total += n; });
+    try {
+      p.run();
+      CHECK_CATCH(runtime_error, e);
+      static_cast<void>(e);
+    }
+    CHECK_EQUAL(1, total);
+  }
+
+}
+
+SUITE(construction) {
+
+  TEST(second_reader) {
+    pipeline p;
+    auto& c = p.make_channel<int>(2);
+    p.add_sink("first", c, [](int&) { });
+    try {
+      p.add_sink("second", c, [](int&) { });
+      CHECK_CATCH(invalid_argument, e);
+      static_cast<void>(e);
+    }
+  }
+
+  TEST(started_twice) {
+    pipeline p;
+    auto& c = p.make_channel<int>(2);
+    p.add_source("one", c, [](auto& out) { out.push(1); });
+    p.add_sink("none", c, [](int&) { });
+    p.start();
+    try {
+      p.start();
+      CHECK_CATCH(logic_error, e);
+      static_cast<void>(e);
+    }
+    p.wait();
+    try {
+      p.run();
+      CHECK_CATCH(logic_error, e);
+      static_cast<void>(e);
+    }
+  }
+
+  TEST(unconnected) {
+    pipeline p;
+    auto& c = p.make_channel<int>(2);
+    p.add_source("only", c, [](auto&) { });
+    try {
+      p.start();
+      CHECK_CATCH(invalid_argument, e);
+      static_cast<void>(e);
+    }
+  }
+
+}
@@ -0,0 +1,183 @@
+//
+// Copyright (c) 2026
+// Kyle Markley.  All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+// 3. Neither the name of the author nor the names of any contributors may be
+//    used to endorse or promote products derived from this software without
+//    specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include "arr/prefetch_traversal.hpp"
+#include <algorithm>
+#include <iterator>
+#include <unordered_map>
+#include <utility>
+
+namespace arr {
+
+namespace {
+
+constexpr char separator = '/';
+
+}
+
+prefetch_iterator::prefetch_iterator(prefetch_traversal * pt)
+  : container(pt)
+{
+  if (container and not container->advance()) container = nullptr;
+}
+
+prefetch_iterator& prefetch_iterator::operator++() {
+  if (not container->advance()) container = nullptr;
+  return *this;
+}
+
+prefetch_iterator::reference prefetch_iterator::operator*() const noexcept {
+  return container->_current;
+}
+
+prefetch_traversal::prefetch_traversal(
+    std::string directory,
+    std::size_t window,
+    dir_order order,
+    visit_type visit,
+    directory_options options,
+    traversal_options rules)
+  : _sequence(std::make_unique<recursive_directory_sequence>(
+        std::move(directory), order, visit, options, std::move(rules)))
+  , _buffer(std::max(window, std::size_t(1u)))
+  , _batch(std::min(batch, _buffer.capacity()))
+{
+  _producer = std::thread([this] { produce(); });
+}
+
+prefetch_traversal::~prefetch_traversal() {
+  _stop.store(true, std::memory_order::relaxed);
+  drain();
+  _producer.join();
+}
+
+void prefetch_traversal::produce() noexcept {
+  std::vector<std::optional<record>> pending;
+  pending.reserve(_batch.size() + 2u);
+  try {
+    auto& rds = *_sequence;
+    auto root_length = rds.root().size();
+    if (rds.root().empty() or separator != rds.root().back()) ++root_length;
+    std::unordered_map<std::string, std::uint32_t> ids;
+    std::string parent_path;
+    std::uint32_t parent = 0u;
+    std::uint32_t depth = 0u;
+    for (auto i = rds.begin(); i != rds.end(); ++i) {
+      if (_stop.load(std::memory_order::relaxed)) break;
+      auto& path = rds.path();
+      if (path != parent_path) {
+        //
+        // Entries of one directory are usually consecutive, so the id is
+        // only looked up when the directory changes.
+        //
+        auto [id, added] = ids.try_emplace(path,
+            static_cast<std::uint32_t>(ids.size()));
+        parent = id->second;
+        parent_path = path;
+        depth = 1u + static_cast<std::uint32_t>(std::count(
+              path.begin() + static_cast<std::ptrdiff_t>(
+                std::min(root_length, path.size())),
+              path.end(), separator));
+        if (added) {
+          record r;
+          r.entry.name = path;
+          r.entry.parent = parent;
+          r.announces = true;
+          pending.emplace_back(std::move(r));
+        }
+      }
+      record r;
+      r.entry.name = i->d_name;
+      r.entry.parent = parent;
+      r.entry.depth = depth;
+      r.entry.type = i->d_type;
+      pending.emplace_back(std::move(r));
+      if (pending.size() >= _batch.size()) flush(pending);
+    }
+  } catch (...) {
+    _failure = std::current_exception();
+  }
+  _produced.splice(_produced.end(), _sequence->exceptions);
+  pending.emplace_back();       // The end of the stream
+  flush(pending);
+}
+
+void prefetch_traversal::flush(std::vector<std::optional<record>>& pending) {
+  auto b = std::make_move_iterator(pending.begin());
+  auto e = std::make_move_iterator(pending.end());
+  while (b != e) {
+    b = _buffer.write(b, e);
+    if (b != e) _buffer.wait_for_read();
+  }
+  pending.clear();
+}
+
+bool prefetch_traversal::advance() {
+  for (;;) {
+    if (_next == _count) {
+      if (_finished) return false;
+      while (_buffer.empty()) _buffer.wait_for_write();
+      auto e = _buffer.read(_batch.begin(), _batch.size());
+      _count = static_cast<std::size_t>(e - _batch.begin());
+      _next = 0u;
+    }
+    auto& r = _batch[_next++];
+    if (not r) {
+      _finished = true;
+      _count = _next;
+      exceptions.splice(exceptions.end(), _produced);
+      if (_failure) std::rethrow_exception(_failure);
+      return false;
+    }
+    if (r->announces) {
+      _directories.push_back(std::move(r->entry.name));
+      continue;
+    }
+    _current = std::move(r->entry);
+    return true;
+  }
+}
+
+void prefetch_traversal::drain() noexcept {
+  while (not _finished) {
+    for (; _next < _count; ++_next) {
+      if (not _batch[_next]) {
+        _finished = true;
+        break;
+      }
+    }
+    if (_finished) break;
+    while (_buffer.empty()) _buffer.wait_for_write();
+    auto e = _buffer.read(_batch.begin(), _batch.size());
+    _count = static_cast<std::size_t>(e - _batch.begin());
+    _next = 0u;
+  }
+}
+
+}
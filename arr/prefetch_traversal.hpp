@@ -0,0 +1,204 @@
+#ifndef ARR_PREFETCH_TRAVERSAL_HPP
+#define ARR_PREFETCH_TRAVERSAL_HPP
+//
+// Copyright (c) 2026
+// Kyle Markley.  All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+// 3. Neither the name of the author nor the names of any contributors may be
+//    used to endorse or promote products derived from this software without
+//    specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include "arr/fifo.hpp"
+#include "arr/recursive_directory_sequence.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace arr {
+
+struct prefetch_traversal;
+
+/// \addtogroup directory_traversal
+/// @{
+
+///
+/// Entry produced by a prefetch_traversal
+///
+/// The entry names its directory by an id rather than by path, so that it
+/// is small to pass between threads; \c prefetch_traversal::path composes
+/// the full path when it is wanted.
+///
+struct prefetched_entry {
+  std::string name;             ///< Name within its directory
+  std::uint32_t parent = 0u;    ///< Id of the directory containing the entry
+  std::uint32_t depth = 0u;     ///< Depth, where entries of the root have 1
+  unsigned char type = 0u;      ///< As \c d_type, resolved if it was unknown
+};
+
+///
+/// Iterator for the entries of a prefetch_traversal
+///
+struct prefetch_iterator {
+  using iterator_category = std::input_iterator_tag;
+  using difference_type   = std::ptrdiff_t;
+  using value_type        = const prefetched_entry;
+  using pointer           = const prefetched_entry*;
+  using reference         = const prefetched_entry&;
+
+  prefetch_iterator() noexcept { }
+  prefetch_iterator(prefetch_traversal * pt);
+  friend bool operator==(
+      const prefetch_iterator& a, const prefetch_iterator& b) {
+    return a.container == b.container;
+  }
+  friend bool operator!=(
+      const prefetch_iterator& a, const prefetch_iterator& b) {
+    return !(a==b);
+  }
+  prefetch_iterator& operator++();
+  reference operator* () const noexcept;
+  pointer   operator->() const noexcept { return &**this; }
+private:
+  prefetch_traversal * container = nullptr;
+};
+
+///
+/// Recursive directory traversal that reads ahead on a background thread
+///
+/// A \c recursive_directory_sequence is run on a thread started by the
+/// constructor, and its entries are passed to the consuming thread through
+/// a fifo of \c window entries.  The traversal stays at most that far ahead
+/// of the consumer, so directory reads overlap with the processing of
+/// entries without reading the whole tree into memory.
+///
+/// Before the first entry of each directory, the path of the directory is
+/// passed once; the iterator records it, so that \c path and \c directory
+/// may be used for any entry already produced.
+///
+/// Destroying the traversal before reaching the end stops the background
+/// thread and discards entries not yet consumed.
+///
+struct prefetch_traversal {
+  using dir_order  = recursive_directory_sequence::dir_order;
+  using visit_type = recursive_directory_sequence::visit_type;
+
+  ///
+  /// Start a prefetch_traversal
+  ///
+  /// @param directory Root of the traversal
+  /// @param window    Most entries read ahead of the consumer
+  /// @param order     Order of the traversal
+  /// @param visit     Type of entries to produce
+  /// @param options   Options for reading each directory
+  /// @param rules     Pruning rules for the traversal
+  ///
+  prefetch_traversal(
+      std::string directory,
+      std::size_t window = 1024u,
+      dir_order order = dir_order::pre,
+      visit_type visit = visit_type::all,
+      directory_options options = {},
+      traversal_options rules = {});
+
+  prefetch_traversal(const prefetch_traversal& ) = delete;
+  prefetch_traversal(      prefetch_traversal&&) = delete;
+  prefetch_traversal& operator=(const prefetch_traversal& ) = delete;
+  prefetch_traversal& operator=(      prefetch_traversal&&) = delete;
+  ~prefetch_traversal();
+
+  ///
+  /// Iterate over the entries
+  ///
+  /// The entries may only be iterated once.  If the background traversal
+  /// threw, the exception is rethrown by the increment reaching the end.
+  ///
+  prefetch_iterator begin() { return prefetch_iterator(this); }
+  prefetch_iterator end() const noexcept { return prefetch_iterator(); }
+
+  ///
+  /// Path of a directory, with a trailing '/'
+  ///
+  /// @param id Id of a directory named by an entry already produced
+  ///
+  const std::string& directory(std::uint32_t id) const {
+    return _directories.at(id);
+  }
+
+  /// Full path of an entry already produced
+  std::string path(const prefetched_entry& entry) const {
+    return directory(entry.parent) + entry.name;
+  }
+
+  ///
+  /// Exceptions encountered during directory traversal
+  ///
+  /// These are available once the end has been reached.
+  ///
+  std::list<std::unique_ptr<syscall_exception>> exceptions;
+
+private:
+  friend prefetch_iterator;
+
+  /// Element of the fifo, with nothing marking the end
+  struct record {
+    prefetched_entry entry;
+    bool announces = false;     ///< Carries the path of directory \c parent
+  };
+  using buffer_type = fifo<std::optional<record>>;
+
+  static constexpr std::size_t batch = 64u;
+
+  void produce() noexcept;
+  void flush(std::vector<std::optional<record>>& pending);
+  bool advance();
+  void drain() noexcept;
+
+  std::unique_ptr<recursive_directory_sequence> _sequence;
+  buffer_type _buffer;
+  std::atomic<bool> _stop {false};
+  std::exception_ptr _failure;          ///< Thrown by the traversal
+  std::list<std::unique_ptr<syscall_exception>> _produced; ///< By producer
+  std::thread _producer;
+  // Used only by the consumer
+  std::vector<std::optional<record>> _batch;
+  std::size_t _next = 0u;               ///< Position in \c _batch
+  std::size_t _count = 0u;              ///< Records read into \c _batch
+  bool _finished = false;               ///< The end was read
+  prefetched_entry _current;
+  std::vector<std::string> _directories;
+};
+
+/// @}
+
+}
+
+#endif
@@ -0,0 +1,132 @@
+//
+// Copyright (c) 2026
+// Kyle Markley.  All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+// 3. Neither the name of the author nor the names of any contributors may be
+//    used to endorse or promote products derived from this software without
+//    specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include "arrtest/arrtest.hpp"
+#include "arr/prefetch_traversal.hpp"
+#include "arr/fcntl.hpp"
+#include "arr/file_descriptor.hpp"
+#include "arr/temp_dir.hpp"
+#include "arr/unistd.hpp"
+#include <map>
+#include <set>
+#include <string>
+
+UNIT_TEST_MAIN
+
+using namespace arr;
+using namespace std;
+
+namespace {
+
+void touch(const string& path) {
+  wrap::file_descriptor fd = wrap::open(SOURCE_CONTEXT,
+      path.c_str(), O_WRONLY|O_CREAT, 0600);
+}
+
+// Root with files a and b, d with c, d/e with f and g, and h with 50 files
+struct tree {
+  tree() : root(string(dir.name()) + "/") {
+    for (auto d : { "d", "d/e", "h" }) {
+      wrap::mkdir(SOURCE_CONTEXT, (root + d).c_str(), 0700);
+    }
+    for (auto f : { "a", "b", "d/c", "d/e/f", "d/e/g" }) touch(root + f);
+    for (int i = 0; i < 50; ++i) touch(root + "h/" + to_string(i));
+  }
+  set<string> expected() {
+    recursive_directory_sequence rds(root);
+    set<string> result;
+    for (auto i = rds.begin(); i != rds.end(); ++i) {
+      result.emplace(rds.full_path());
+    }
+    return result;
+  }
+  temp_dir dir;
+  string root;
+};
+
+}
+
+SUITE(prefetch) {
+
+  TEST(same_entries) {
+    tree t;
+    for (size_t window : { 1u, 2u, 7u, 1024u }) {
+      prefetch_traversal pt(t.root, window);
+      set<string> found;
+      for (auto& e : pt) found.insert(pt.path(e));
+      CHECK_EQUAL(true, (t.expected() == found));
+      CHECK_EQUAL(0u, pt.exceptions.size());
+    }
+  }
+
+  TEST(entries) {
+    tree t;
+    prefetch_traversal pt(t.root);
+    map<string, prefetched_entry> found;
+    for (auto& e : pt) found[pt.path(e).substr(t.root.size())] = e;
+    CHECK_EQUAL(58u, found.size());
+    CHECK_EQUAL(1u, found["a"].depth);
+    CHECK_EQUAL(DT_REG, found["a"].type);
+    CHECK_EQUAL(DT_DIR, found["d/e"].type);
+    CHECK_EQUAL(2u, found["d/e"].depth);
+    CHECK_EQUAL(3u, found["d/e/g"].depth);
+    CHECK_EQUAL("g", found["d/e/g"].name);
+    CHECK_EQUAL(t.root + "d/e/", pt.directory(found["d/e/g"].parent));
+    CHECK_EQUAL(found["d/e/f"].parent, found["d/e/g"].parent);
+    CHECK_EQUAL(0u, found["a"].parent);
+    CHECK_EQUAL(t.root, pt.directory(0u));
+  }
+
+  TEST(post_order) {
+    tree t;
+    prefetch_traversal pt(t.root, 4u,
+        prefetch_traversal::dir_order::post,
+        prefetch_traversal::visit_type::directory);
+    set<string> found;
+    for (auto& e : pt) found.insert(pt.path(e).substr(t.root.size()));
+    CHECK_EQUAL(true, (found == set<string>{"d", "d/e", "h"}));
+  }
+
+  TEST(early_stop) {
+    tree t;
+    prefetch_traversal pt(t.root, 2u);
+    auto i = pt.begin();
+    CHECK_EQUAL(true, i != pt.end());
+    ++i;
+    // Destruction stops the producer, which is blocked on the full fifo
+  }
+
+  TEST(missing_root) {
+    temp_dir d;
+    prefetch_traversal pt(string(d.name()) + "/missing");
+    CHECK_EQUAL(true, pt.begin() == pt.end());
+    CHECK_EQUAL(1u, pt.exceptions.size());
+  }
+
+}
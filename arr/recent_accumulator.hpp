@@ -1,7 +1,7 @@
 #ifndef ARR_RECENT_ACCUMULATOR_HPP
 #define ARR_RECENT_ACCUMULATOR_HPP
 //
-// Copyright (c) 2013, 2021, 2023
+// Copyright (c) 2013, 2021, 2023, 2026
 // Kyle Markley.  All rights reserved.
 //
 // Redistribution and use in source and binary forms, with or without
@@ -44,6 +44,10 @@ struct recent_accumulator {
 
   constexpr recent_accumulator() noexcept : _recent(0u), _total(0u) { }
 
+  /// Resume accumulating from a previously observed total
+  constexpr explicit recent_accumulator(size_type previous) noexcept
+    : _recent(0u), _total(previous) { }
+
   /// Total value of the accumulator
   size_type total () const noexcept { return _total.load(acquire); }
 
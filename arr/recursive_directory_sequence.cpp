@@ -1,5 +1,5 @@
 //
-// Copyright (c) 2012, 2013, 2021, 2022
+// Copyright (c) 2012, 2013, 2021, 2022, 2026
 // Kyle Markley.  All rights reserved.
 //
 // Redistribution and use in source and binary forms, with or without
@@ -28,14 +28,19 @@
 //
 
 #include "arr/recursive_directory_sequence.hpp"
+#include "arr/fcntl.hpp"
+#include "arr/path_match.hpp"
+#include <algorithm>
 #include <cstdlib>
+#include <stdexcept>
 #include <utility>
 #include <tuple>
 
 //
-// Note that all exceptions related to system calls are caught by the
+// Note that exceptions related to reading directories are caught by the
 // underlying directory_sequence objects.  The recursive_directory_sequence
-// merely needs to gather those exceptions; it does not need to catch any.
+// merely needs to gather those exceptions, and to catch its own from
+// checking for a filesystem boundary.
 //
 
 namespace {
@@ -54,46 +59,39 @@ recursive_directory_iterator::recursive_directory_iterator(
   if (container) {
     container->descend(container->root());
     //
+    // When resuming at an entry already visited, move past it as though it
+    // had just been produced.
+    //
+    bool visited = container->resume();
+    //
     // If using post-order for directories, descend into them.
     //
-    if (recursive_directory_sequence::dir_order::post == container->order) {
+    if (not visited and
+        recursive_directory_sequence::dir_order::post == container->order) {
       descend_while_directory();
     }
     ascend_while_complete();
     update_entry();
+    if (visited) advance();
     filter();
   }
 }
 
 void recursive_directory_iterator::filter() {
-  switch (container->visit) {
-    case recursive_directory_sequence::visit_type::all:
-      break;
-    case recursive_directory_sequence::visit_type::directory:
-      while (entry and DT_DIR != entry->d_type) advance();
-      break;
-    case recursive_directory_sequence::visit_type::file:
-      while (entry and DT_REG != entry->d_type) advance();
-      break;
-    case recursive_directory_sequence::visit_type::link:
-      while (entry and DT_LNK != entry->d_type) advance();
-      break;
-    case recursive_directory_sequence::visit_type::non_dir:
-      while (entry and DT_DIR == entry->d_type) advance();
-      break;
+  while (entry and not container->visits(container->context.back().second)) {
+    advance();
   }
 }
 
 void recursive_directory_iterator::descend() {
-  auto& iter = container->context.back().second;
-  container->descend(container->path() + iter->d_name);
+  container->descend(container->context.back().second);
 }
 
 void recursive_directory_iterator::descend_while_directory() {
   auto& context = container->context;
   const directory_iterator end;
   while (end != context.back().second and
-      DT_DIR == context.back().second->d_type) {
+      container->descends(context.back().second)) {
     descend();
   }
 }
@@ -101,16 +99,21 @@ void recursive_directory_iterator::descend_while_directory() {
 void recursive_directory_iterator::ascend_while_complete() {
   auto& context = container->context;
   const directory_iterator end;
-  while (not context.empty() and end == context.back().second) {
-    container->ascend();
-  }
+  do {
+    while (not context.empty() and end == context.back().second) {
+      container->ascend();
+    }
+  } while (context.empty() and container->next());
 }
 
 void recursive_directory_iterator::update_entry() {
   if (container->context.empty()) {
     entry = nullptr;
   } else {
-    entry = &*container->context.back().second;
+    auto& iter = container->context.back().second;
+    container->resolve(iter);   // Before filtering or descending
+    entry = &*iter;
+    container->compose(*entry);
   }
 }
 
@@ -123,8 +126,9 @@ recursive_directory_iterator& recursive_directory_iterator::operator++() {
 void recursive_directory_iterator::advance() {
   //
   // If there is an abandon_request, we will abandon the current directory
-  // unless the current entry is a directory and we are dir_order::pre.  In
-  // that case we don't abandon anything -- we simply don't descend into it.
+  // unless the current entry is a directory and we are dir_order::pre or
+  // dir_order::breadth.  In that case we don't abandon anything -- we simply
+  // don't descend into it.
   //
   // If we abandon a directory, we should not increment the iterator, because
   // the act of abandoning moves us to the proper position in the sequence.
@@ -132,7 +136,7 @@ void recursive_directory_iterator::advance() {
   bool abandoned_directory = false;
   if (entry and container->abandon_request) {
     if (not (DT_DIR == entry->d_type and
-          recursive_directory_sequence::dir_order::pre == container->order)) {
+          recursive_directory_sequence::dir_order::post != container->order)) {
       container->ascend();
       ascend_while_complete();
       update_entry();
@@ -144,7 +148,7 @@ void recursive_directory_iterator::advance() {
     auto& iter    = context.back().second;
     switch (container->order) {
       case recursive_directory_sequence::dir_order::pre:
-        if (DT_DIR == entry->d_type and not container->abandon_request) {
+        if (not container->abandon_request and container->descends(iter)) {
           descend();
         }
         if (not abandoned_directory) {
@@ -157,6 +161,16 @@ void recursive_directory_iterator::advance() {
           descend_while_directory();
         }
         break;
+      case recursive_directory_sequence::dir_order::breadth:
+        if (not container->abandon_request and container->descends(iter)) {
+          container->pending.emplace_back(
+              std::string(container->compose(*iter)) + '/',
+              container->_base_depth + context.size());
+        }
+        if (not abandoned_directory) {
+          ++iter;
+        }
+        break;
     }
     container->abandon_request = false;
     ascend_while_complete();
@@ -165,21 +179,235 @@ void recursive_directory_iterator::advance() {
 }
 
 recursive_directory_iterator recursive_directory_sequence::begin() {
+  if (dir_order::breadth == order and not rules.resume_after.empty()) {
+    throw std::invalid_argument("cannot resume a breadth-first traversal");
+  }
   return recursive_directory_iterator(this);
 }
 
+unsigned char recursive_directory_sequence::resolve(directory_iterator& i) {
+  return rules.follow_symlinks ? i.follow() : i.type();
+}
+
+bool recursive_directory_sequence::visits(directory_iterator& i) {
+  auto& entry = *i;
+  switch (visit) {
+    case visit_type::all:
+      break;
+    case visit_type::directory:
+      if (DT_DIR != entry.d_type) return false;
+      break;
+    case visit_type::file:
+      if (DT_REG != entry.d_type) return false;
+      break;
+    case visit_type::link:
+      if (DT_LNK != entry.d_type) return false;
+      break;
+    case visit_type::non_dir:
+      if (DT_DIR == entry.d_type) return false;
+      break;
+  }
+  if (not rules.include.empty() and not matches(rules.include, entry)) {
+    return false;
+  }
+  if (matches(rules.exclude, entry)) return false;
+  if (rules.unique_files and DT_DIR != entry.d_type) {
+    try {
+      struct stat sb;
+      wrap::fstatat(SOURCE_CONTEXT, i.dir_fd(), entry.d_name, &sb,
+          rules.follow_symlinks ? 0 : AT_SYMLINK_NOFOLLOW);
+      if (sb.st_nlink > 1 and not files.insert(sb.st_dev, sb.st_ino)) {
+        return false;
+      }
+    } catch (syscall_exception&) {
+      // Dangling link, or removed: visit it
+    }
+  }
+  return true;
+}
+
+bool recursive_directory_sequence::descends(directory_iterator& entry) {
+  if (DT_DIR != resolve(entry)) return false;
+  if (_base_depth + context.size() >= rules.max_depth) return false;
+  if (matches(rules.exclude, *entry)) return false;
+  if (rules.one_filesystem or rules.follow_symlinks) {
+    try {
+      struct stat sb;
+      wrap::fstatat(SOURCE_CONTEXT, entry.dir_fd(), entry->d_name, &sb,
+          rules.follow_symlinks ? 0 : AT_SYMLINK_NOFOLLOW);
+      if (rules.one_filesystem and device != sb.st_dev) return false;
+      if (rules.follow_symlinks and
+          not directories.insert(sb.st_dev, sb.st_ino)) {
+        return false;
+      }
+    } catch (syscall_exception& e) {
+      record(e, "fstatat", &*entry);
+      return false;
+    }
+  }
+  return true;
+}
+
+bool recursive_directory_sequence::matches(
+    const std::vector<std::string>& patterns,
+    const struct dirent& entry) {
+  std::string_view relative;
+  for (auto& pattern : patterns) {
+    if (std::string::npos == pattern.find('/')) {
+      if (path_match(pattern, entry.d_name)) return true;
+    } else {
+      if (relative.empty()) {
+        relative = compose(entry).substr(_root_length);
+      }
+      if (path_match(pattern, relative)) return true;
+    }
+  }
+  return false;
+}
+
+std::string_view recursive_directory_sequence::compose(
+    const struct dirent& entry) {
+  _full_path.resize(_lengths.back());
+  _full_path += entry.d_name;
+  return _full_path;
+}
+
+void recursive_directory_sequence::record(syscall_exception& e,
+    const char * operation, const struct dirent * entry) {
+  if (not options.errors) {
+    exceptions.emplace_back(e.clone());
+    return;
+  }
+  options.errors->record(e.code().value(), operation,
+      [&](std::string& buffer) {
+        if (entry) {
+          buffer += compose(*entry);
+        } else {
+          buffer += context.back().first.path();
+        }
+      });
+}
+
 void recursive_directory_sequence::ascend() {
   steal(exceptions, context.back().first.exceptions);
   context.pop_back();
+  _lengths.pop_back();
+  if (not context.empty() and context.size() == _detached) {
+    --_detached;
+    _full_path.resize(_lengths.back());
+    context.back().second.reopen(_full_path.c_str());
+  }
 }
 
-void recursive_directory_sequence::descend(std::string subdir) {
-  if (not context.empty()) steal(exceptions, context.back().first.exceptions);
+void recursive_directory_sequence::descend(std::string root) {
   context.emplace_back(
       std::piecewise_construct,
-      std::forward_as_tuple(std::move(subdir)),
+      std::forward_as_tuple(std::move(root), options),
+      std::forward_as_tuple());
+  auto& [ds, iter] = context.back();
+  iter = ds.begin();
+  _full_path = ds.path();
+  _lengths.assign(1u, _full_path.size());
+  _root_length = _full_path.size();
+  _base_depth = 0u;
+  _detached = 0u;
+  pending.clear();
+  if ((rules.one_filesystem or rules.follow_symlinks) and iter != ds.end()) {
+    try {
+      struct stat sb;
+      wrap::fstat(SOURCE_CONTEXT, iter.dir_fd(), &sb);
+      device = sb.st_dev;
+      if (rules.follow_symlinks) directories.insert(sb.st_dev, sb.st_ino);
+    } catch (syscall_exception& e) {
+      record(e, "fstat", nullptr);
+    }
+  }
+}
+
+void recursive_directory_sequence::descend(const directory_iterator& subdir) {
+  auto& parent = context.back().first;
+  steal(exceptions, parent.exceptions);
+  compose(*subdir);
+  _full_path += '/';
+  _lengths.push_back(_full_path.size());
+  context.emplace_back(
+      std::piecewise_construct,
+      std::forward_as_tuple(parent, subdir),
       std::forward_as_tuple());
   context.back().second = context.back().first.begin();
+  limit_open();
+}
+
+bool recursive_directory_sequence::next() {
+  if (pending.empty()) return false;
+  auto [path, depth] = std::move(pending.front());
+  pending.pop_front();
+  _base_depth = depth;
+  context.emplace_back(
+      std::piecewise_construct,
+      std::forward_as_tuple(std::move(path), options),
+      std::forward_as_tuple());
+  auto& [ds, iter] = context.back();
+  iter = ds.begin();
+  _full_path = ds.path();
+  _lengths.assign(1u, _full_path.size());
+  return true;
+}
+
+void recursive_directory_sequence::limit_open() {
+  auto limit = std::max<std::size_t>(1u, rules.max_open_directories);
+  while (context.size() - _detached > limit) {
+    context[_detached].second.detach();
+    ++_detached;
+  }
+}
+
+///
+/// Position the traversal at the entry named by \c rules.resume_after
+///
+/// Each directory on the cursor's path is read up to the entry of that
+/// name, without resolving the type of the entries skipped, and the entry
+/// is descended into unless it is the last.
+///
+/// @return Whether the traversal is positioned at an entry already visited
+///
+bool recursive_directory_sequence::resume() {
+  std::string_view rest = rules.resume_after;
+  const directory_iterator end;
+  while (not rest.empty()) {
+    auto slash = rest.find('/');
+    auto name = rest.substr(0, slash);
+    rest = std::string::npos == slash ? "" : rest.substr(slash + 1u);
+    auto& iter = context.back().second;
+    while (end != iter and name != iter->d_name) ++iter;
+    if (end == iter) {
+      //
+      // The entry is gone, so there is no telling which of the others were
+      // visited.  Read the directory again by path, as its parent may have
+      // been closed.
+      //
+      steal(exceptions, context.back().first.exceptions);
+      context.pop_back();
+      _full_path.resize(_lengths.back());
+      context.emplace_back(
+          std::piecewise_construct,
+          std::forward_as_tuple(_full_path, options),
+          std::forward_as_tuple());
+      context.back().second = context.back().first.begin();
+      return false;
+    }
+    if (rest.empty()) return true;
+    //
+    // A directory is visited before its contents in pre-order, and after
+    // them in post-order.  In pre-order, its parent moves past it on
+    // descending, as in advance.
+    //
+    if (not descends(iter)) return dir_order::pre == order;
+    descend(iter);
+    if (dir_order::pre == order) ++iter;
+    if (end == context.back().second) return false;
+  }
+  return false;
 }
 
 }
@@ -1,7 +1,7 @@
 #ifndef ARR_RECURSIVE_DIRECTORY_SEQUENCE_HPP
 #define ARR_RECURSIVE_DIRECTORY_SEQUENCE_HPP
 //
-// Copyright (c) 2012, 2014, 2021, 2022
+// Copyright (c) 2012, 2014, 2021, 2022, 2026
 // Kyle Markley.  All rights reserved.
 //
 // Redistribution and use in source and binary forms, with or without
@@ -30,8 +30,16 @@
 //
 
 #include "arr/directory_sequence.hpp"
+#include "arr/inode_set.hpp"
+#include <sys/types.h>
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <string>
+#include <string_view>
 #include <utility>
 #include <deque>
+#include <vector>
 
 namespace arr {
 
@@ -40,6 +48,59 @@ struct recursive_directory_sequence;
 /// \addtogroup directory_traversal
 /// @{
 
+///
+/// Pruning rules for a recursive directory traversal
+///
+/// The rules are evaluated before an entry is produced, so a directory that
+/// is excluded, too deep, or on another filesystem is never opened.
+///
+/// A pattern containing '/' is matched by \c path_match against the path of
+/// the entry relative to the root.  Any other pattern is matched against the
+/// name of the entry.
+///
+/// When following symbolic links, an entry that is a link has the type of
+/// its target, and a link to a directory is descended into.  Each directory
+/// is descended into at most once, identified by device and inode number,
+/// which breaks cycles.  Only directories are remembered for this.
+///
+/// For unique files, a file with more than one link is visited only under
+/// the first name found.  Only such files are remembered for this.
+///
+/// Each of these sets is an \c inode_set whose table is bounded by
+/// \c max_inode_table bytes; beyond that, it holds files in bitmaps of inode
+/// numbers, so that memory stays bounded for hundreds of millions of files.
+///
+/// A depth-first traversal keeps every directory from the root to the
+/// current one open.  With \c max_open_directories, the shallowest open
+/// directories beyond that number have their remaining entries read into
+/// memory and are closed, and each is opened again by path on returning to
+/// it.  A breadth-first traversal only ever has one directory open.
+///
+/// A depth-first traversal may resume after an entry visited by an earlier
+/// one, given the \c recursive_directory_sequence::cursor of that entry.
+/// The directories leading to the entry are read again only as far as the
+/// names on its path, and no subtree before it is descended into, so a
+/// long traversal may be checkpointed and continued by another process,
+/// or on another machine with the tree under a different root.
+///
+struct traversal_options {
+  std::vector<std::string> include; ///< If any, visit only matching entries
+  std::vector<std::string> exclude; ///< Neither visit nor descend into these
+  std::size_t max_depth = std::numeric_limits<std::size_t>::max();
+                                    ///< Deepest entries to visit, where
+                                    ///< entries of the root have depth 1
+  bool one_filesystem = false;      ///< Do not descend into other filesystems
+  bool follow_symlinks = false;     ///< Treat a symbolic link as its target
+  bool unique_files = false;        ///< Visit a file with several links once
+  std::size_t max_inode_table = inode_set::default_max_table;
+                                    ///< Bytes of each table of files
+                                    ///< remembered, before it is compacted
+  std::size_t max_open_directories = std::numeric_limits<std::size_t>::max();
+                                    ///< Directories open at once, at least 1
+  std::string resume_after;         ///< Cursor of the last entry visited, if
+                                    ///< resuming; not for breadth-first
+};
+
 ///
 /// Iterator for the sequence of files in a directory tree
 ///
@@ -82,6 +143,7 @@ struct recursive_directory_sequence {
   enum class dir_order {
     pre,        ///< Visit directory entry before contents of the directory
     post,       ///< Visit directory entry after contents of the directory
+    breadth,    ///< Visit all entries of a depth before those deeper
   };
   enum class visit_type {
     all,        ///< Visit all entries
@@ -93,12 +155,24 @@ struct recursive_directory_sequence {
   recursive_directory_sequence(
       std::string directory,
       dir_order desired_order = dir_order::pre,
-      visit_type desired_visit = visit_type::all
+      visit_type desired_visit = visit_type::all,
+      directory_options desired_options = {},
+      traversal_options desired_rules = {}
       )
     : _root(std::move(directory))
     , order(desired_order)
     , visit(desired_visit)
+    , options(desired_options)
+    , rules(std::move(desired_rules))
+    , directories(rules.max_inode_table)
+    , files(rules.max_inode_table)
   { }
+  ///
+  /// Start the traversal
+  ///
+  /// Throws \c std::invalid_argument when resuming a breadth-first
+  /// traversal, whose position a cursor cannot describe.
+  ///
   recursive_directory_iterator begin();
   recursive_directory_iterator end() const noexcept {
     return recursive_directory_iterator();
@@ -106,21 +180,62 @@ struct recursive_directory_sequence {
   const std::string& root() const { return _root; }
   const std::string& path() const { return context.back().first.path(); }
 
+  ///
+  /// Path of the current entry
+  ///
+  /// The path is composed in a buffer that is reused for every entry, so
+  /// obtaining it performs no allocation once the buffer has grown to the
+  /// longest path.  It is null-terminated, and is valid until the iterator
+  /// is incremented.
+  ///
+  std::string_view full_path() const noexcept { return _full_path; }
+
+  ///
+  /// Descriptor of the directory containing the current entry
+  ///
+  /// The entry may be operated upon relative to this descriptor, for example
+  /// with fstatat or unlinkat, without resolving its path.  The descriptor
+  /// is valid until the iterator is incremented.
+  ///
+  int dir_fd() const noexcept { return context.back().second.dir_fd(); }
+
+  ///
+  /// Position of the current entry, for resuming the traversal
+  ///
+  /// This is the path of the entry relative to the root: for each open
+  /// directory, the name of the entry being visited within it.  Giving it
+  /// as \c traversal_options::resume_after continues after this entry.
+  ///
+  /// Entries are found again by name, as a position within a directory is
+  /// not meaningful to another process.  Directories are expected to list
+  /// their entries in the same order, as they do while unmodified.  If an
+  /// entry named by the cursor no longer exists, its directory is read again
+  /// from the beginning, so that no entry is missed, although some may be
+  /// visited again.  Directories and files remembered for \c follow_symlinks
+  /// and \c unique_files are not carried over.
+  ///
+  std::string_view cursor() const noexcept {
+    auto path = full_path();
+    return path.substr(std::min(_root_length, path.size()));
+  }
+
   ///
   /// Abandon the currently-processing directory
   ///
   /// When the iterator currently refers to a directory and the object was
-  /// configured for \c dir_order::pre, that directory shall not be descended
-  /// into.  In all other cases, the current directory is abandoned, and the
-  /// next iterator increment shall not refer to a file in the current
-  /// directory.  (For \c dir_order::post, it will refer to the directory
-  /// that was just abandoned.)
+  /// configured for \c dir_order::pre or \c dir_order::breadth, that
+  /// directory shall not be descended into.  In all other cases, the current
+  /// directory is abandoned, and the next iterator increment shall not refer
+  /// to a file in the current directory.  (For \c dir_order::post, it will
+  /// refer to the directory that was just abandoned.)
   ///
   void abandon() noexcept { abandon_request = true; }
 
   ///
   /// Exceptions encountered during directory traversal
   ///
+  /// These are not used if the options give a \c directory_error_log.
+  ///
   std::list<std::unique_ptr<syscall_exception>> exceptions;
 private:
   friend recursive_directory_iterator;
@@ -128,9 +243,34 @@ private:
   std::string _root;
   const dir_order order;
   const visit_type visit;
+  const directory_options options;
+  const traversal_options rules;
+  dev_t device = 0;             ///< Filesystem of the root
+  std::deque<std::pair<std::string, std::size_t>> pending;
+                                ///< Directories and depths, if breadth-first
+  std::size_t _base_depth = 0;  ///< Depth of the first directory in context
+  std::size_t _root_length = 0; ///< Length of the root's path
+  std::size_t _detached = 0;    ///< Directories in context that are closed
+  inode_set directories;        ///< Directories descended into, if following
+  inode_set files;              ///< Files with several links, if unique
   bool abandon_request = false;
+  std::string _full_path;       ///< Current entry, or directory with '/'
+  std::vector<std::size_t> _lengths;
+                                ///< Length of each directory's path
+  unsigned char resolve(directory_iterator& entry);
+  bool visits(directory_iterator& entry);
+  bool descends(directory_iterator& entry);
+  bool matches(const std::vector<std::string>& patterns,
+      const struct dirent& entry);
+  std::string_view compose(const struct dirent& entry);
+  void record(syscall_exception& e,
+      const char * operation, const struct dirent * entry);
   void ascend();
-  void descend(std::string subdir);
+  void descend(std::string root);
+  void descend(const directory_iterator& subdir);
+  bool next();
+  void limit_open();
+  bool resume();
 };
 
 /// @}
@@ -1,5 +1,5 @@
 //
-// Copyright (c) 2012, 2013, 2015, 2021, 2023
+// Copyright (c) 2012, 2013, 2015, 2021, 2023, 2026
 // Kyle Markley.  All rights reserved.
 //
 // Redistribution and use in source and binary forms, with or without
@@ -44,20 +44,74 @@ inline dirent make_dirent(const char * name, decltype(dirent::d_type) type) {
   return entry;
 }
 
+#include <cstddef>
 #include <string>
 #include <list>
 #include <map>
+#include <set>
 using mock_dir = std::list<dirent>;
 
 std::map<std::string, mock_dir> filesystem;
 std::map<mock_dir*, mock_dir::iterator> iterators;
+std::map<int, std::string> descriptors;
+std::set<std::string> mounts;
+std::map<std::string, std::string> links;       // Symbolic links to targets
+std::map<std::string, std::string> hard_links;  // Files to shared identity
+
+// Path with symbolic links replaced by their targets
+std::string resolve(std::string path) {
+  for (bool again = true; again; ) {
+    again = false;
+    for (auto& [link, target] : links) {
+      if (0 == path.compare(0, link.size(), link)) {
+        path = target + path.substr(link.size());
+        again = true;
+      }
+    }
+  }
+  return path;
+}
 
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <cerrno>
+#include <functional>
+#include <utility>
 #include "arr/source_context.hpp"
+#include "arr/file_descriptor.hpp"
+#include "arr/syscall_exception.hpp"
 namespace mock {
   namespace wrap {
 
-    inline DIR * opendir(arr::source_context, const char * filename) {
-      auto& dir = filesystem[filename];
+    // Descriptors are fictitious, so closing one only forgets it
+    struct file_descriptor {
+      file_descriptor() noexcept { }
+      file_descriptor(int descriptor) noexcept : fd(descriptor) { }
+      file_descriptor(file_descriptor&& peer) noexcept
+        : fd(peer.release()) { }
+      file_descriptor& operator=(file_descriptor&& peer) noexcept {
+        std::swap(fd, peer.fd);
+        return *this;
+      }
+      bool valid() const noexcept { return -1 != fd; }
+      int get() const noexcept { return fd; }
+      int release() noexcept { return std::exchange(fd, -1); }
+    private:
+      int fd = -1;
+    };
+
+    inline int openat(arr::source_context,
+        int fd, const char * path, int, mode_t) {
+      std::string name = AT_FDCWD == fd ? "" : descriptors.at(fd);
+      name += path;
+      if ('/' != name.back()) name += '/';
+      auto result = 1000 + static_cast<int>(descriptors.size());
+      descriptors[result] = name;
+      return result;
+    }
+
+    inline DIR * fdopendir(arr::source_context, int fd) {
+      auto& dir = filesystem[resolve(descriptors.at(fd))];
       iterators[&dir] = dir.begin();
       return reinterpret_cast<DIR*>(&dir);
     }
@@ -67,18 +121,74 @@ namespace mock {
       iterators.erase(p);
     }
 
+    // Like readdir(3), return a copy owned by the directory stream
     inline struct dirent * readdir(arr::source_context, DIR * dirp) {
+      static std::map<mock_dir*, dirent> buffers;
       auto p = reinterpret_cast<mock_dir*>(dirp);
       auto& iter = iterators[p];
       if (iter == p->end()) {
         return nullptr;
       } else {
-        auto& entry = *iter;
+        auto& entry = buffers[p];
+        entry = *iter;
         ++iter;
         return &entry;
       }
     }
 
+    // Directories are those with contents in the filesystem, and a link
+    // whose target is not a directory is dangling
+    inline void fstatat(arr::source_context,
+        int fd, const char * path, struct stat * sb, int flag) {
+      auto name = descriptors.at(fd) + path + '/';
+      memset(sb, 0, sizeof(*sb));
+      if ((flag & AT_SYMLINK_NOFOLLOW) and links.count(name)) {
+        sb->st_mode = S_IFLNK;
+        return;
+      }
+      auto target = resolve(name);
+      if (target != name and not filesystem.count(target)) {
+        throw ::arr::syscall_exception(SOURCE_CONTEXT, "fstatat", ENOENT);
+      }
+      sb->st_mode = filesystem.count(target) ? S_IFDIR : S_IFREG;
+      sb->st_dev = mounts.count(target) ? 2 : 1;
+      sb->st_nlink = hard_links.count(target) ? 2 : 1;
+      sb->st_ino = std::hash<std::string>()(
+          hard_links.count(target) ? hard_links[target] : target);
+    }
+
+    inline void fstat(arr::source_context, int fd, struct stat * sb) {
+      auto target = resolve(descriptors.at(fd));
+      memset(sb, 0, sizeof(*sb));
+      sb->st_mode = S_IFDIR;
+      sb->st_dev = mounts.count(target) ? 2 : 1;
+      sb->st_ino = std::hash<std::string>()(target);
+    }
+
+    // Pack as many records as fit, in the layout of linux_dirent64
+    inline size_t getdents64(arr::source_context,
+        int fd, void * buf, size_t nbytes) {
+      auto p = &filesystem[resolve(descriptors.at(fd))];
+      auto& iter = iterators[p];
+      auto out = static_cast<char*>(buf);
+      size_t used = 0;
+      for (; iter != p->end(); ++iter) {
+        const auto header = offsetof(struct dirent, d_name);
+        auto length = strlen(iter->d_name) + 1;
+        auto reclen = (header + length + 7) / 8 * 8;
+        if (used + reclen > nbytes) break;
+        auto record = out + used;
+        memset(record, 0, reclen);
+        memcpy(record + offsetof(struct dirent, d_reclen),
+            &reclen, sizeof(dirent::d_reclen));
+        memcpy(record + offsetof(struct dirent, d_type),
+            &iter->d_type, sizeof(dirent::d_type));
+        memcpy(record + header, iter->d_name, length);
+        used += reclen;
+      }
+      return used;
+    }
+
   }
 }
 
@@ -103,17 +213,31 @@ namespace mock {
 
 // Includes from header
 #include "arr/directory.hpp"
+#include "arr/directory_error_log.hpp"
 #include "arr/syscall_exception.hpp"
+#include <cstddef>
 #include <iterator>
 #include <string>
 #include <list>
 #include <memory>
 // Includes from implementation
 #include "arr/dirent.hpp"
+#include "arr/fcntl.hpp"
+#include "arr/file_descriptor.hpp"
+#include "arr/path_exception.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
 #include <utility>
+#include <vector>
+#include <unistd.h>
+#include <sys/syscall.h>
 
 namespace mock {
   namespace arr {
+    using ::arr::directory_error_log;
+    using ::arr::path_exception;
     using ::arr::syscall_exception;
     using ::arr::source_context;
   }
@@ -126,12 +250,27 @@ namespace mock {
 
 // Includes from header
 #include "arr/directory_sequence.hpp"
+#include "arr/inode_set.hpp"
+#include <sys/types.h>
+#include <cstddef>
+#include <limits>
+#include <string_view>
+#include <utility>
 #include <deque>
+#include <vector>
 // Includes from implementation
+#include "arr/fcntl.hpp"
+#include "arr/path_match.hpp"
+#include <algorithm>
+#include <cstdlib>
 #include <utility>
 #include <tuple>
 
 namespace mock {
+  namespace arr {
+    using ::arr::inode_set;
+    using ::arr::path_match;
+  }
 #include "arr/recursive_directory_sequence.cpp"
 }
 
@@ -221,6 +360,44 @@ next_sub1: ;
     }
 next_base: ;
   }
+  // As from a filesystem that does not report types
+  const dirent file1 = make_dirent("file1", DT_UNKNOWN);
+  const dirent dir1 = make_dirent("dir1", DT_UNKNOWN);
+  filesystem["/unknown/"] = { dir1, file1 };
+  filesystem["/unknown/dir1/"] = { file1, dir1 };
+  filesystem["/unknown/dir1/dir1/"] = { };
+  // For pruning, with another filesystem mounted on mnt
+  const dirent a = make_dirent("a.cpp", DT_REG);
+  const dirent b = make_dirent("b.o", DT_REG);
+  const dirent c = make_dirent("c.cpp", DT_REG);
+  const dirent d = make_dirent("d.cpp", DT_REG);
+  const dirent z = make_dirent("z.cpp", DT_REG);
+  const dirent keep = make_dirent("keep", DT_DIR);
+  const dirent deep = make_dirent("deep", DT_DIR);
+  const dirent mnt = make_dirent("mnt", DT_DIR);
+  const dirent node_modules = make_dirent("node_modules", DT_DIR);
+  filesystem["/prune/"] = { a, keep, mnt, node_modules, b };
+  filesystem["/prune/keep/"] = { c, node_modules, deep };
+  filesystem["/prune/keep/deep/"] = { d };
+  filesystem["/prune/keep/node_modules/"] = { z };
+  filesystem["/prune/node_modules/"] = { z };
+  filesystem["/prune/mnt/"] = { z };
+  mounts.insert("/prune/mnt/");
+  // For following links, with a loop and a dangling link
+  filesystem["/links/"] = {
+    make_dirent("dir", DT_DIR),
+    make_dirent("loop", DT_LNK),
+    make_dirent("to_dir", DT_LNK),
+    make_dirent("dangling", DT_LNK),
+    make_dirent("a", DT_REG),
+    make_dirent("b", DT_REG),
+  };
+  filesystem["/links/dir/"] = { make_dirent("f", DT_REG) };
+  links["/links/loop/"] = "/links/";
+  links["/links/to_dir/"] = "/links/dir/";
+  links["/links/dangling/"] = "/nowhere/";
+  hard_links["/links/a/"] = "a";
+  hard_links["/links/b/"] = "a";
 }
 
 }
@@ -263,6 +440,9 @@ void check_for(
   arr::test::evaluator& evaluator = *global_evaluator;
   CHECK_EQUAL(false, rds.end() == i);
   CHECK_EQUAL(name, rds.path()+i->d_name);
+  CHECK_EQUAL(name, std::string(rds.full_path()));
+  CHECK_EQUAL('\0', rds.full_path().data()[rds.full_path().size()]);
+  CHECK_EQUAL(rds.path(), descriptors.at(rds.dir_fd()));
   ++i;
 }
 
@@ -272,15 +452,21 @@ void check(
     mock::arr::recursive_directory_sequence::dir_order order
       = mock::arr::recursive_directory_sequence::dir_order::pre,
     mock::arr::recursive_directory_sequence::visit_type visit
-      = mock::arr::recursive_directory_sequence::visit_type::all
+      = mock::arr::recursive_directory_sequence::visit_type::all,
+    const mock::arr::traversal_options& rules = {}
       )
 {
-  mock::arr::recursive_directory_sequence rds(root, order, visit);
-  auto i = rds.begin();
-  for (auto& part : expected) {
-    check_for(rds, i, root+'/'+part);
+  for (auto reader : {
+      mock::arr::directory_reader::readdir,
+      mock::arr::directory_reader::bulk }) {
+    mock::arr::recursive_directory_sequence rds(root, order, visit,
+        { .reader = reader }, rules);
+    auto i = rds.begin();
+    for (auto& part : expected) {
+      check_for(rds, i, root+'/'+part);
+    }
+    check_end(rds, i);
   }
-  check_end(rds, i);
 }
 
 }
@@ -987,6 +1173,200 @@ SUITE(visit) {
     check(root, lnk, order, v_lnk);
     check(root, nd , order, v_nd );
   }
+
+  TEST(unknown) {
+    global_evaluator = &evaluator;
+    string root = "/unknown";
+    list<string> all = { "dir1", "dir1/file1", "dir1/dir1", "file1" };
+    list<string> dir = { "dir1", "dir1/dir1" };
+    list<string> reg = { "dir1/file1", "file1" };
+    list<string> post = { "dir1/file1", "dir1/dir1", "dir1", "file1" };
+    auto pre   = mock::arr::recursive_directory_sequence::dir_order::pre;
+    auto v_all = mock::arr::recursive_directory_sequence::visit_type::all;
+    auto v_dir = mock::arr::recursive_directory_sequence::visit_type::directory;
+    auto v_reg = mock::arr::recursive_directory_sequence::visit_type::file;
+    check(root, all, pre, v_all);
+    check(root, dir, pre, v_dir);
+    check(root, reg, pre, v_reg);
+    check(root, post,
+        mock::arr::recursive_directory_sequence::dir_order::post, v_all);
+  }
+}
+
+SUITE(prune) {
+
+  auto pre  = mock::arr::recursive_directory_sequence::dir_order::pre;
+  auto post = mock::arr::recursive_directory_sequence::dir_order::post;
+  auto v_all = mock::arr::recursive_directory_sequence::visit_type::all;
+
+  size_t opened(const std::string& path) {
+    size_t count = 0;
+    for (auto& [fd, name] : descriptors) {
+      if (name == path) ++count;
+    }
+    return count;
+  }
+
+  TEST(exclude) {
+    global_evaluator = &evaluator;
+    string root = "/prune";
+    mock::arr::traversal_options rules;
+    rules.exclude = { "node_modules" };
+    check(root, { "a.cpp", "keep", "keep/c.cpp", "keep/deep",
+        "keep/deep/d.cpp", "mnt", "mnt/z.cpp", "b.o" }, pre, v_all, rules);
+    check(root, { "a.cpp", "keep/c.cpp", "keep/deep/d.cpp", "keep/deep",
+        "keep", "mnt/z.cpp", "mnt", "b.o" }, post, v_all, rules);
+    rules.exclude = { "node_modules", "keep/*", "*.o" };
+    check(root, { "a.cpp", "keep", "mnt", "mnt/z.cpp" }, pre, v_all, rules);
+    CHECK_EQUAL(0u, opened("/prune/node_modules/"));
+    CHECK_EQUAL(0u, opened("/prune/keep/node_modules/"));
+  }
+
+  TEST(include) {
+    global_evaluator = &evaluator;
+    string root = "/prune";
+    mock::arr::traversal_options rules;
+    rules.exclude = { "node_modules" };
+    rules.include = { "*.cpp" };
+    check(root, { "a.cpp", "keep/c.cpp", "keep/deep/d.cpp", "mnt/z.cpp" },
+        pre, v_all, rules);
+    rules.include = { "keep/**/*.cpp" };
+    check(root, { "keep/c.cpp", "keep/deep/d.cpp" }, pre, v_all, rules);
+  }
+
+  TEST(max_depth) {
+    global_evaluator = &evaluator;
+    string root = "/prune";
+    mock::arr::traversal_options rules;
+    rules.exclude = { "node_modules" };
+    rules.max_depth = 1u;
+    check(root, { "a.cpp", "keep", "mnt", "b.o" }, pre, v_all, rules);
+    rules.max_depth = 2u;
+    check(root, { "a.cpp", "keep/c.cpp", "keep/deep", "keep", "mnt/z.cpp",
+        "mnt", "b.o" }, post, v_all, rules);
+  }
+
+  TEST(one_filesystem) {
+    global_evaluator = &evaluator;
+    string root = "/prune";
+    mock::arr::traversal_options rules;
+    rules.exclude = { "node_modules" };
+    rules.one_filesystem = true;
+    auto mnt = opened("/prune/mnt/");
+    check(root, { "a.cpp", "keep", "keep/c.cpp", "keep/deep",
+        "keep/deep/d.cpp", "mnt", "b.o" }, pre, v_all, rules);
+    CHECK_EQUAL(mnt, opened("/prune/mnt/"));
+  }
+
+}
+
+SUITE(order) {
+
+  auto pre  = mock::arr::recursive_directory_sequence::dir_order::pre;
+  auto post = mock::arr::recursive_directory_sequence::dir_order::post;
+  auto breadth = mock::arr::recursive_directory_sequence::dir_order::breadth;
+  auto v_all = mock::arr::recursive_directory_sequence::visit_type::all;
+  auto v_dir = mock::arr::recursive_directory_sequence::visit_type::directory;
+
+  // Greatest number of directory streams open at once during a traversal
+  size_t most_open(
+      mock::arr::recursive_directory_sequence::dir_order order,
+      const mock::arr::traversal_options& rules) {
+    auto before = iterators.size();
+    size_t most = 0;
+    mock::arr::recursive_directory_sequence rds("/prune", order, v_all,
+        {}, rules);
+    for (auto i = rds.begin(); i != rds.end(); ++i) {
+      most = std::max(most, iterators.size() - before);
+    }
+    return most;
+  }
+
+  TEST(breadth) {
+    global_evaluator = &evaluator;
+    string root = "/prune";
+    mock::arr::traversal_options rules;
+    rules.exclude = { "node_modules" };
+    check(root, { "a.cpp", "keep", "mnt", "b.o", "keep/c.cpp", "keep/deep",
+        "mnt/z.cpp", "keep/deep/d.cpp" }, breadth, v_all, rules);
+    check(root, { "keep", "mnt", "keep/deep" }, breadth, v_dir, rules);
+    rules.max_depth = 2u;
+    check(root, { "a.cpp", "keep", "mnt", "b.o", "keep/c.cpp", "keep/deep",
+        "mnt/z.cpp" }, breadth, v_all, rules);
+    rules.max_depth = 3u;
+    rules.exclude = { "node_modules", "keep/deep" };
+    check(root, { "a.cpp", "keep", "mnt", "b.o", "keep/c.cpp",
+        "mnt/z.cpp" }, breadth, v_all, rules);
+    CHECK_EQUAL(1u, most_open(breadth, rules));
+  }
+
+  TEST(bounded) {
+    global_evaluator = &evaluator;
+    string root = "/prune";
+    mock::arr::traversal_options rules;
+    rules.exclude = { "node_modules" };
+    CHECK_EQUAL(3u, most_open(pre, rules));
+    for (size_t limit : { 1u, 2u }) {
+      rules.max_open_directories = limit;
+      check(root, { "a.cpp", "keep", "keep/c.cpp", "keep/deep",
+          "keep/deep/d.cpp", "mnt", "mnt/z.cpp", "b.o" }, pre, v_all, rules);
+      check(root, { "a.cpp", "keep/c.cpp", "keep/deep/d.cpp", "keep/deep",
+          "keep", "mnt/z.cpp", "mnt", "b.o" }, post, v_all, rules);
+      CHECK_EQUAL(limit, most_open(pre, rules));
+      CHECK_EQUAL(limit, most_open(post, rules));
+    }
+  }
+
+}
+
+SUITE(follow) {
+
+  auto pre  = mock::arr::recursive_directory_sequence::dir_order::pre;
+  auto post = mock::arr::recursive_directory_sequence::dir_order::post;
+  auto v_all = mock::arr::recursive_directory_sequence::visit_type::all;
+  auto v_dir = mock::arr::recursive_directory_sequence::visit_type::directory;
+  auto v_lnk = mock::arr::recursive_directory_sequence::visit_type::link;
+
+  TEST(not_following) {
+    global_evaluator = &evaluator;
+    string root = "/links";
+    list<string> all = {
+      "dir", "dir/f", "loop", "to_dir", "dangling", "a", "b" };
+    check(root, all, pre, v_all);
+    check(root, { "loop", "to_dir", "dangling" }, pre, v_lnk);
+  }
+
+  TEST(following) {
+    global_evaluator = &evaluator;
+    string root = "/links";
+    mock::arr::traversal_options rules;
+    rules.follow_symlinks = true;
+    list<string> all = {
+      "dir", "dir/f", "loop", "to_dir", "dangling", "a", "b" };
+    check(root, all, pre, v_all, rules);
+    check(root, { "dir", "loop", "to_dir" }, post, v_dir, rules);
+    check(root, { "dangling" }, pre, v_lnk, rules);
+  }
+
+  TEST(following_first) {
+    global_evaluator = &evaluator;
+    string root = "/links";
+    mock::arr::traversal_options rules;
+    rules.follow_symlinks = true;
+    rules.exclude = { "dir" };
+    check(root, { "loop", "to_dir", "to_dir/f", "dangling", "a", "b" },
+        pre, v_all, rules);
+  }
+
+  TEST(unique) {
+    global_evaluator = &evaluator;
+    string root = "/links";
+    mock::arr::traversal_options rules;
+    rules.unique_files = true;
+    check(root, { "dir", "dir/f", "loop", "to_dir", "dangling", "a" },
+        pre, v_all, rules);
+  }
+
 }
 
 SUITE(abandon) {
@@ -1235,5 +1615,113 @@ SUITE(abandon) {
 
 }
 
+SUITE(resume) {
+
+  auto pre  = mock::arr::recursive_directory_sequence::dir_order::pre;
+  auto post = mock::arr::recursive_directory_sequence::dir_order::post;
+  auto breadth = mock::arr::recursive_directory_sequence::dir_order::breadth;
+  auto v_all = mock::arr::recursive_directory_sequence::visit_type::all;
+  auto v_file = mock::arr::recursive_directory_sequence::visit_type::file;
+
+  // Entries of a traversal, relative to the root and separated by spaces
+  string walk(
+      const string& root,
+      mock::arr::recursive_directory_sequence::dir_order order,
+      mock::arr::recursive_directory_sequence::visit_type visit,
+      const mock::arr::traversal_options& rules,
+      mock::arr::directory_reader reader,
+      std::list<string> * cursors = nullptr) {
+    mock::arr::recursive_directory_sequence rds(root, order, visit,
+        { .reader = reader }, rules);
+    string result;
+    for (auto i = rds.begin(); i != rds.end(); ++i) {
+      if (cursors) cursors->emplace_back(rds.cursor());
+      result += ' ';
+      result += rds.cursor();
+    }
+    return result;
+  }
+
+  // Cursors after which resuming does not produce the remainder of the
+  // traversal, or "none" if the traversal gave no cursor
+  std::list<string> resume_failures(
+      const string& root,
+      mock::arr::recursive_directory_sequence::dir_order order,
+      mock::arr::recursive_directory_sequence::visit_type visit,
+      mock::arr::traversal_options rules = {}) {
+    std::list<string> failures;
+    for (auto reader : {
+        mock::arr::directory_reader::readdir,
+        mock::arr::directory_reader::bulk }) {
+      std::list<string> cursors;
+      rules.resume_after.clear();
+      auto all = walk(root, order, visit, rules, reader, &cursors);
+      if (cursors.empty()) failures.emplace_back("none");
+      for (auto& cursor : cursors) {
+        rules.resume_after = cursor;
+        auto rest = all.substr(all.find(' ' + cursor + ' ' ) + 1u +
+            cursor.size());
+        if (cursor == cursors.back()) rest.clear();
+        if (rest != walk(root, order, visit, rules, reader)) {
+          failures.push_back(cursor);
+        }
+      }
+    }
+    return failures;
+  }
+
+  TEST(cursor) {
+    global_evaluator = &evaluator;
+    string root = "/test-6-4-5";
+    mock::arr::recursive_directory_sequence rds(root, pre);
+    auto i = rds.begin();
+    CHECK_EQUAL(string("dir1"), string(rds.cursor()));
+    check_for(rds, i, root+"/dir1");
+    check_for(rds, i, root+"/dir1/file1");
+    check_for(rds, i, root+"/dir1/dir1");
+    check_for(rds, i, root+"/dir2");
+    CHECK_EQUAL(string("dir2/dir1"), string(rds.cursor()));
+  }
+
+  TEST(every_entry) {
+    global_evaluator = &evaluator;
+    mock::arr::traversal_options rules;
+    rules.exclude = { "node_modules" };
+    for (auto order : { pre, post }) {
+      CHECK_EQUAL(0u, resume_failures("/test-6-4-5", order, v_all).size());
+      CHECK_EQUAL(0u, resume_failures("/test-6-4-5", order, v_file).size());
+      CHECK_EQUAL(0u, resume_failures("/prune", order, v_all, rules).size());
+      CHECK_EQUAL(0u, resume_failures("/prune", order, v_file, rules).size());
+    }
+    rules.max_open_directories = 1u;
+    CHECK_EQUAL(0u, resume_failures("/prune", pre, v_all, rules).size());
+  }
+
+  TEST(missing) {
+    global_evaluator = &evaluator;
+    string root = "/test-6-4-5";
+    mock::arr::traversal_options rules;
+    rules.resume_after = "dir2/gone";
+    check(root, { "dir2/dir1", "dir2/file1" }, pre, v_all, rules);
+    check(root, { "dir2/dir1", "dir2/file1", "dir2" }, post, v_all, rules);
+    rules.resume_after = "gone/file1";
+    check(root, { "dir1", "dir1/file1", "dir1/dir1", "dir2", "dir2/dir1",
+        "dir2/file1" }, pre, v_all, rules);
+  }
+
+  TEST(breadth) {
+    global_evaluator = &evaluator;
+    mock::arr::traversal_options rules;
+    rules.resume_after = "dir1";
+    mock::arr::recursive_directory_sequence rds("/test-6-4-5", breadth,
+        v_all, {}, rules);
+    try {
+      rds.begin();
+      CHECK_CATCH(std::invalid_argument, e);
+    }
+  }
+
+}
+
 SUITE(errors) {
 }
@@ -0,0 +1,179 @@
+//
+// Copyright (c) 2026
+// Kyle Markley.  All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+// 3. Neither the name of the author nor the names of any contributors may be
+//    used to endorse or promote products derived from this software without
+//    specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include "arr/remove_tree.hpp"
+#include "arr/cstdio.hpp"
+#include "arr/fcntl.hpp"
+#include "arr/parallel_directory_traversal.hpp"
+#include "arr/recursive_directory_sequence.hpp"
+#include "arr/unistd.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unistd.h>
+
+namespace arr {
+
+namespace {
+
+void remove_serial(const std::string& directory) {
+  recursive_directory_sequence rds(directory,
+      recursive_directory_sequence::dir_order::post);
+  for (auto& entry : rds) {
+    wrap::unlinkat(SOURCE_CONTEXT, rds.dir_fd(), entry.d_name,
+        DT_DIR == entry.d_type ? AT_REMOVEDIR : 0);
+  }
+  if (not rds.exceptions.empty()) rds.exceptions.front()->raise();
+  wrap::rmdir(SOURCE_CONTEXT, directory.c_str());
+}
+
+void remove_parallel(const std::string& directory, unsigned threads) {
+  parallel_directory_traversal pdt(directory, threads);
+  try {
+    pdt.run(
+        [](const parallel_directory_entry& e) {
+          if (DT_DIR != e.entry.d_type) {
+            wrap::unlinkat(SOURCE_CONTEXT, e.dir_fd, e.entry.d_name, 0);
+          }
+        },
+        // Each directory is removed once its subtree is
+        [](const parallel_directory_exit& e) {
+          wrap::unlinkat(SOURCE_CONTEXT, e.parent_fd, e.name.c_str(),
+              AT_REMOVEDIR);
+        });
+  } catch (syscall_exception&) {
+    // A directory left unread is the cause of its removal failing
+    if (not pdt.exceptions.empty()) pdt.exceptions.front()->raise();
+    throw;
+  }
+  if (not pdt.exceptions.empty()) pdt.exceptions.front()->raise();
+}
+
+/// Thread removing trees that were renamed aside
+struct background_removal {
+  ~background_removal() {
+    {
+      std::lock_guard<std::mutex> guard(lock);
+      stopping = true;
+    }
+    changed.notify_all();
+    if (thread.joinable()) thread.join();
+  }
+
+  void add(std::string directory) {
+    {
+      std::lock_guard<std::mutex> guard(lock);
+      queue.push_back(std::move(directory));
+      if (not thread.joinable()) thread = std::thread([this] { run(); });
+    }
+    changed.notify_all();
+  }
+
+  void wait() {
+    std::unique_lock<std::mutex> guard(lock);
+    changed.wait(guard, [this] { return queue.empty() and not busy; });
+  }
+
+  void run() {
+    std::unique_lock<std::mutex> guard(lock);
+    for (;;) {
+      changed.wait(guard, [this] { return stopping or not queue.empty(); });
+      if (queue.empty()) return;
+      auto directory = std::move(queue.front());
+      queue.pop_front();
+      busy = true;
+      guard.unlock();
+      try {
+        remove_parallel(directory, 0u);
+      } catch (...) {
+        // Nobody remains to report to
+      }
+      guard.lock();
+      busy = false;
+      changed.notify_all();
+    }
+  }
+
+  std::mutex lock;
+  std::condition_variable changed;
+  std::deque<std::string> queue;
+  bool busy = false;
+  bool stopping = false;
+  std::thread thread;
+};
+
+background_removal& background() {
+  static background_removal instance;
+  return instance;
+}
+
+/// Unique name beside a directory
+std::string aside(std::string directory) {
+  static std::atomic<unsigned long> counter {0u};
+  while (directory.size() > 1u and '/' == directory.back()) {
+    directory.pop_back();
+  }
+  directory += ".removing.";
+  directory += std::to_string(::getpid());
+  directory += '.';
+  directory += std::to_string(counter.fetch_add(1u));
+  return directory;
+}
+
+}
+
+void remove_tree(const std::string& directory, removal how, unsigned threads) {
+  switch (how) {
+    case removal::serial:
+      remove_serial(directory);
+      break;
+    case removal::parallel:
+      remove_parallel(directory, threads);
+      break;
+    case removal::background: {
+      auto target = aside(directory);
+      try {
+        wrap::rename(SOURCE_CONTEXT, directory.c_str(), target.c_str());
+      } catch (syscall_exception&) {
+        remove_parallel(directory, threads);
+        break;
+      }
+      background().add(std::move(target));
+      break;
+    }
+  }
+}
+
+void wait_for_background_removal() {
+  background().wait();
+}
+
+}
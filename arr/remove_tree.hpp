@@ -0,0 +1,82 @@
+#ifndef ARR_REMOVE_TREE_HPP
+#define ARR_REMOVE_TREE_HPP
+//
+// Copyright (c) 2026
+// Kyle Markley.  All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+// 3. Neither the name of the author nor the names of any contributors may be
+//    used to endorse or promote products derived from this software without
+//    specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <string>
+
+namespace arr {
+
+/// \addtogroup directory_traversal
+/// @{
+
+///
+/// How a directory tree is removed
+///
+enum class removal {
+  serial,       ///< By the calling thread
+  parallel,     ///< By several threads
+  background,   ///< Renamed aside, then removed by a background thread
+};
+
+///
+/// Remove a directory and everything in it
+///
+/// @param directory Directory to remove
+/// @param how       How to remove it
+/// @param threads   Number of threads for parallel removal (0 for the
+///                  number of CPUs)
+///
+/// Entries are removed with unlinkat relative to a descriptor of their
+/// directory.  In parallel, the non-directories are removed by a
+/// parallel_directory_traversal, and each directory is removed, relative to
+/// a descriptor of its parent, by the worker that empties it.
+///
+/// In the background, the directory is first renamed to a unique name
+/// beside it, so it is gone from its path when this returns, and then it is
+/// removed in parallel by a thread shared by all background removals.
+/// Errors in the background are not reported.  If the directory cannot be
+/// renamed, it is removed in parallel before returning.  Background
+/// removals are completed before the program exits.
+///
+void remove_tree(
+    const std::string& directory,
+    removal how = removal::serial,
+    unsigned threads = 0u);
+
+///
+/// Wait for all removals in the background to complete
+///
+void wait_for_background_removal();
+
+/// @}
+
+}
+
+#endif
@@ -0,0 +1,127 @@
+//
+// Copyright (c) 2026
+// Kyle Markley.  All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+// 3. Neither the name of the author nor the names of any contributors may be
+//    used to endorse or promote products derived from this software without
+//    specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include "arrtest/arrtest.hpp"
+#include "arr/remove_tree.hpp"
+#include "arr/fcntl.hpp"
+#include "arr/file_descriptor.hpp"
+#include "arr/path_exception.hpp"
+#include "arr/recursive_directory_sequence.hpp"
+#include "arr/temp_dir.hpp"
+#include "arr/unistd.hpp"
+#include <iostream>
+#include <string>
+#include <unistd.h>
+
+UNIT_TEST_MAIN
+
+using namespace arr;
+using namespace std;
+
+namespace {
+
+// Tree of nested directories, each holding files and a symbolic link
+string make_tree(const string& root, unsigned depth, unsigned width) {
+  wrap::mkdir(SOURCE_CONTEXT, root.c_str(), 0700);
+  for (unsigned i = 0; i < width; ++i) {
+    auto file = root + "/f" + to_string(i);
+    wrap::open(SOURCE_CONTEXT, file.c_str(), O_WRONLY|O_CREAT, 0600);
+  }
+  // Must be removed, not followed
+  CHECK_EQUAL(0, ::symlink("/", (root + "/link").c_str()));
+  if (depth) {
+    for (unsigned i = 0; i < width; ++i) {
+      make_tree(root + "/d" + to_string(i), depth - 1u, width);
+    }
+  }
+  return root;
+}
+
+bool exists(const string& path) {
+  try {
+    wrap::file_descriptor fd = wrap::open(SOURCE_CONTEXT,
+        path.c_str(), O_RDONLY|O_DIRECTORY, 0);
+    return true;
+  } catch (path_exception& e) {
+    if (e.code() != std::errc::no_such_file_or_directory) {
+      cerr << e.what() << '\n';
+    }
+    return false;
+  }
+}
+
+// Number of entries in a directory
+unsigned count(const string& path) {
+  unsigned n = 0;
+  recursive_directory_sequence rds(path);
+  for (auto i = rds.begin(); i != rds.end(); ++i) ++n;
+  return n;
+}
+
+}
+
+SUITE(tree) {
+
+  TEST(serial) {
+    temp_dir dir;
+    auto root = make_tree(string(dir.name()) + "/t", 2u, 4u);
+    remove_tree(root);
+    CHECK_EQUAL(false, exists(root));
+    CHECK_EQUAL(0u, count(dir.name()));
+  }
+
+  TEST(parallel) {
+    temp_dir dir;
+    auto root = make_tree(string(dir.name()) + "/t", 3u, 5u);
+    remove_tree(root, removal::parallel, 4u);
+    CHECK_EQUAL(false, exists(root));
+    CHECK_EQUAL(0u, count(dir.name()));
+  }
+
+  TEST(background) {
+    temp_dir dir;
+    auto root = make_tree(string(dir.name()) + "/t", 3u, 5u);
+    remove_tree(root, removal::background);
+    CHECK_EQUAL(false, exists(root));
+    wait_for_background_removal();
+    CHECK_EQUAL(0u, count(dir.name()));
+  }
+
+  TEST(missing) {
+    temp_dir dir;
+    auto root = string(dir.name()) + "/missing";
+    try {
+      remove_tree(root, removal::parallel);
+      CHECK(0);
+    } catch (syscall_exception& e) {
+      CHECK_EQUAL(true, e.code() == std::errc::no_such_file_or_directory);
+    }
+  }
+
+}
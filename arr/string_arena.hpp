@@ -0,0 +1,191 @@
+#ifndef ARR_STRING_ARENA_HPP
+#define ARR_STRING_ARENA_HPP
+//
+// Copyright (c) 2026
+// Kyle Markley.  All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+// 3. Neither the name of the author nor the names of any contributors may be
+//    used to endorse or promote products derived from this software without
+//    specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <string_view>
+#include <vector>
+
+namespace arr {
+
+///
+/// \ingroup miscellaneous
+/// Sequence of strings stored contiguously
+///
+/// The characters of every string are kept in one arena, each followed by a
+/// null terminator, and the start of each string in a vector of offsets.
+/// Compared to a container of \c std::string, there is no allocation per
+/// string and no per-string header, and iteration reads memory in order.
+///
+/// The strings are presented as a random-access range of
+/// \c std::string_view.  Views and \c c_str pointers are invalidated by any
+/// modification.
+///
+struct string_arena {
+  using value_type      = std::string_view;
+  using size_type       = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference       = std::string_view;
+  using const_reference = std::string_view;
+
+  ///
+  /// Random-access iterator producing each string by value
+  ///
+  struct iterator {
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type        = std::string_view;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = void;
+    using reference         = std::string_view;
+
+    iterator() noexcept { }
+    iterator(const string_arena * a, size_type i) noexcept
+      : arena(a), index(i) { }
+    reference operator*() const noexcept { return (*arena)[index]; }
+    reference operator[](difference_type n) const noexcept {
+      return (*arena)[index + static_cast<size_type>(n)];
+    }
+    iterator& operator++() noexcept { ++index; return *this; }
+    iterator& operator--() noexcept { --index; return *this; }
+    iterator operator++(int) noexcept { auto r = *this; ++index; return r; }
+    iterator operator--(int) noexcept { auto r = *this; --index; return r; }
+    iterator& operator+=(difference_type n) noexcept {
+      index += static_cast<size_type>(n);
+      return *this;
+    }
+    iterator& operator-=(difference_type n) noexcept { return *this += -n; }
+    friend iterator operator+(iterator i, difference_type n) noexcept {
+      return i += n;
+    }
+    friend iterator operator+(difference_type n, iterator i) noexcept {
+      return i += n;
+    }
+    friend iterator operator-(iterator i, difference_type n) noexcept {
+      return i -= n;
+    }
+    friend difference_type operator-(iterator a, iterator b) noexcept {
+      return static_cast<difference_type>(a.index - b.index);
+    }
+    friend bool operator==(iterator a, iterator b) noexcept {
+      return a.index == b.index;
+    }
+    friend auto operator<=>(iterator a, iterator b) noexcept {
+      return a.index <=> b.index;
+    }
+  private:
+    const string_arena * arena = nullptr;
+    size_type index = 0u;
+  };
+  using const_iterator = iterator;
+
+  string_arena() : _offsets(1u, 0u) { }
+
+  ///
+  /// Reserve storage
+  ///
+  /// @param count      Number of strings
+  /// @param characters Total size of the strings and their terminators
+  ///
+  void reserve(size_type count, size_type characters) {
+    _offsets.reserve(count + 1u);
+    _characters.reserve(characters);
+  }
+
+  /// Append a string
+  void push_back(std::string_view s) {
+    _characters.insert(_characters.end(), s.begin(), s.end());
+    _characters.push_back('\0');
+    _offsets.push_back(_characters.size());
+  }
+
+  void clear() noexcept {
+    _characters.clear();
+    _offsets.resize(1u);
+  }
+
+  size_type size() const noexcept { return _offsets.size() - 1u; }
+  bool empty() const noexcept { return 1u == _offsets.size(); }
+
+  /// Total size of the strings and their terminators
+  size_type characters() const noexcept { return _characters.size(); }
+
+  std::string_view operator[](size_type i) const noexcept {
+    return std::string_view(_characters.data() + _offsets[i],
+        _offsets[i + 1u] - _offsets[i] - 1u);
+  }
+  const char * c_str(size_type i) const noexcept {
+    return _characters.data() + _offsets[i];
+  }
+  std::string_view front() const noexcept { return (*this)[0]; }
+  std::string_view back() const noexcept { return (*this)[size() - 1u]; }
+
+  iterator begin() const noexcept { return iterator(this, 0u); }
+  iterator end() const noexcept { return iterator(this, size()); }
+
+  ///
+  /// Sort the strings
+  ///
+  /// @param less Ordering of \c std::string_view
+  ///
+  /// The order is found over indexes, and the arena is then rebuilt once in
+  /// that order, so that iteration stays sequential in memory.
+  ///
+  template <typename Compare = std::less<std::string_view>>
+  void sort(Compare less = Compare()) {
+    std::vector<size_type> order(size());
+    std::iota(order.begin(), order.end(), size_type(0));
+    std::sort(order.begin(), order.end(), [&](size_type a, size_type b) {
+      return less((*this)[a], (*this)[b]);
+    });
+    string_arena sorted;
+    sorted.reserve(size(), characters());
+    for (auto i : order) sorted.push_back((*this)[i]);
+    swap(sorted);
+  }
+
+  void swap(string_arena& peer) noexcept {
+    _characters.swap(peer._characters);
+    _offsets.swap(peer._offsets);
+  }
+  friend void swap(string_arena& a, string_arena& b) noexcept { a.swap(b); }
+
+private:
+  std::vector<char> _characters;        ///< Strings, each null-terminated
+  std::vector<size_type> _offsets;      ///< Start of each string, and end
+};
+
+}
+
+#endif
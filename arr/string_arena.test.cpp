@@ -0,0 +1,104 @@
+//
+// Copyright (c) 2026
+// Kyle Markley.  All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+// 3. Neither the name of the author nor the names of any contributors may be
+//    used to endorse or promote products derived from this software without
+//    specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include "arrtest/arrtest.hpp"
+#include "arr/string_arena.hpp"
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <string>
+#include <vector>
+
+UNIT_TEST_MAIN
+
+using namespace arr;
+using namespace std;
+
+SUITE(arena) {
+
+  TEST(empty) {
+    string_arena a;
+    CHECK_EQUAL(true, a.empty());
+    CHECK_EQUAL(0u, a.size());
+    CHECK_EQUAL(true, a.begin() == a.end());
+  }
+
+  TEST(push_back) {
+    string_arena a;
+    a.push_back("one");
+    a.push_back("");
+    a.push_back("three");
+    CHECK_EQUAL(3u, a.size());
+    CHECK_EQUAL("one", string(a[0]));
+    CHECK_EQUAL("", string(a[1]));
+    CHECK_EQUAL("three", string(a.back()));
+    CHECK_EQUAL(0, strcmp("three", a.c_str(2)));
+    CHECK_EQUAL(11u, a.characters());
+  }
+
+  TEST(random_access) {
+    string_arena a;
+    for (auto s : { "a", "bb", "ccc", "dddd" }) a.push_back(s);
+    static_assert(is_same_v<random_access_iterator_tag,
+        iterator_traits<string_arena::iterator>::iterator_category>);
+    auto i = a.begin();
+    CHECK_EQUAL(4, a.end() - i);
+    CHECK_EQUAL("ccc", string(i[2]));
+    CHECK_EQUAL("dddd", string(*(i + 3)));
+    CHECK_EQUAL("ccc", string(*--(a.end() - 1)));
+    CHECK_EQUAL(true, i < a.end());
+    vector<string> copy(a.begin(), a.end());
+    CHECK_EQUAL(true, (copy == vector<string>{"a", "bb", "ccc", "dddd"}));
+  }
+
+  TEST(sort) {
+    string_arena a;
+    for (auto s : { "pear", "apple", "fig", "banana" }) a.push_back(s);
+    a.sort();
+    vector<string> sorted(a.begin(), a.end());
+    CHECK_EQUAL(true,
+        (sorted == vector<string>{"apple", "banana", "fig", "pear"}));
+    CHECK_EQUAL(0, strcmp("fig", a.c_str(2)));
+    a.sort(greater<string_view>());
+    CHECK_EQUAL("pear", string(a.front()));
+    CHECK_EQUAL(true, is_sorted(a.begin(), a.end(), greater<string_view>()));
+  }
+
+  TEST(clear) {
+    string_arena a;
+    a.push_back("x");
+    a.clear();
+    CHECK_EQUAL(true, a.empty());
+    CHECK_EQUAL(0u, a.characters());
+    a.push_back("y");
+    CHECK_EQUAL("y", string(a.front()));
+  }
+
+}
@@ -1,5 +1,5 @@
 //
-// Copyright (c) 2012, 2013, 2021, 2023
+// Copyright (c) 2012, 2013, 2021, 2023, 2026
 // Kyle Markley.  All rights reserved.
 //
 // Redistribution and use in source and binary forms, with or without
@@ -29,12 +29,8 @@
 
 #include "arr/temp_dir.hpp"
 #include "arr/cstdlib.hpp"
-#include "arr/unistd.hpp"
-#include "arr/recursive_directory_sequence.hpp"
 #include "arr/temp_template.hpp"
 #include <cstring>
-#include <list>
-#include <string>
 
 namespace arr {
 
@@ -47,19 +43,14 @@ temp_dir::temp_dir()
   wrap::mkdtemp(SOURCE_CONTEXT, dirname.get());
 }
 
+temp_dir::temp_dir(removal how)
+  : temp_dir()
+{
+  _removal = how;
+}
+
 temp_dir::~temp_dir() {
-  if (dirname) {
-    recursive_directory_sequence rds(name(),
-        recursive_directory_sequence::dir_order::post);
-    for (auto& entry : rds) {
-      if (DT_DIR == entry.d_type) {
-        wrap::rmdir(SOURCE_CONTEXT, (rds.path() + entry.d_name).c_str());
-      } else {
-        wrap::unlink(SOURCE_CONTEXT, (rds.path() + entry.d_name).c_str());
-      }
-    }
-    wrap::rmdir(SOURCE_CONTEXT, name());
-  }
+  if (dirname) remove_tree(name(), _removal);
 }
 
 }
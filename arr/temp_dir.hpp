@@ -1,7 +1,7 @@
 #ifndef ARR_TEMP_DIR_HPP
 #define ARR_TEMP_DIR_HPP
 //
-// Copyright (c) 2012, 2021
+// Copyright (c) 2012, 2021, 2026
 // Kyle Markley.  All rights reserved.
 //
 // Redistribution and use in source and binary forms, with or without
@@ -29,6 +29,7 @@
 // POSSIBILITY OF SUCH DAMAGE.
 //
 
+#include "arr/remove_tree.hpp"
 #include <memory>
 
 namespace arr {
@@ -38,11 +39,15 @@ namespace arr {
 /// Temporary directory
 ///
 /// The temporary directory, including all files in it, will be removed
-/// (recursively) when this object is destroyed.
+/// (recursively) when this object is destroyed.  A large directory may be
+/// removed in parallel, or in the background so that destruction returns
+/// immediately; see \c remove_tree.
 ///
 struct temp_dir {
   ~temp_dir();  ///< Remove the temporary directory
   temp_dir();   ///< Create a temporary directory
+  /// Create a temporary directory, to be removed as specified
+  explicit temp_dir(removal how);
   temp_dir(const temp_dir& ) = delete;
   temp_dir(      temp_dir&&) = default;
   temp_dir& operator=(const temp_dir& ) = delete;
@@ -50,6 +55,7 @@ struct temp_dir {
   const char * name() const noexcept { return dirname.get(); }
 private:
   std::unique_ptr<char[]> dirname;
+  removal _removal = removal::serial;
 };
 
 }
@@ -1,5 +1,5 @@
 //
-// Copyright (c) 2012, 2013, 2015, 2021
+// Copyright (c) 2012, 2013, 2015, 2021, 2026
 // Kyle Markley.  All rights reserved.
 //
 // Redistribution and use in source and binary forms, with or without
@@ -92,4 +92,26 @@ SUITE(all) {
     }
   }
 
+  TEST(background) {
+    std::string name;
+    {
+      temp_dir t(removal::background);
+      name = t.name();
+      std::string a_subdir = name+"/subdir";
+      std::string a_file   = name+"/subdir/file";
+      wrap::mkdir(SOURCE_CONTEXT, a_subdir.c_str(), 0700);
+      wrap::open (SOURCE_CONTEXT, a_file.c_str(), O_RDWR|O_CREAT, 0600);
+    }
+    try {
+      // Temporary dir should have been renamed aside by the destructor
+      wrap::rmdir(SOURCE_CONTEXT, name.c_str());
+      CHECK(0);
+    } catch (arr::path_exception& e) {
+      bool correct = e.code() == std::errc::no_such_file_or_directory;
+      CHECK(correct);
+      if (not correct) cerr << e.what() << '\n';
+    }
+    wait_for_background_removal();
+  }
+
 }
@@ -0,0 +1,268 @@
+//
+// Copyright (c) 2026
+// Kyle Markley.  All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+// 3. Neither the name of the author nor the names of any contributors may be
+//    used to endorse or promote products derived from this software without
+//    specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+//
+// Benchmark of full walks over synthetic directory trees.
+//
+// Trees of three shapes are built in a temporary directory: one wide flat
+// directory, one deep chain of directories, and a mixed tree of moderate
+// fan-out.  Each is walked with recursive_directory_sequence in every order
+// and with several visit types, with both directory readers, and with the
+// parallel and prefetching traversals.
+//
+// Usage: arr-bench-traversal [entries [cold]]
+//
+// With "cold", caches are dropped before every walk: through
+// /proc/sys/vm/drop_caches where that is writable, and otherwise by advising
+// the kernel with posix_fadvise that each directory's data is not needed,
+// which some filesystems honor.
+//
+
+#include "arr/fcntl.hpp"
+#include "arr/file_descriptor.hpp"
+#include "arr/parallel_directory_traversal.hpp"
+#include "arr/prefetch_traversal.hpp"
+#include "arr/recursive_directory_sequence.hpp"
+#include "arr/temp_dir.hpp"
+#include "arr/unistd.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+using arr::recursive_directory_sequence;
+using dir_order  = recursive_directory_sequence::dir_order;
+using visit_type = recursive_directory_sequence::visit_type;
+using walk_type  = std::function<std::size_t(const std::string&)>;
+
+constexpr std::size_t files_per_directory = 32u;
+constexpr std::size_t fan_out = 8u;
+constexpr std::size_t deepest = 400u;    // Within the usual descriptor limit
+
+void touch(const std::string& path) {
+  wrap::file_descriptor fd = wrap::open(SOURCE_CONTEXT,
+      path.c_str(), O_WRONLY|O_CREAT, 0600);
+}
+
+void make_directory(const std::string& path) {
+  wrap::mkdir(SOURCE_CONTEXT, path.c_str(), 0700);
+}
+
+void make_files(const std::string& dir, std::size_t count) {
+  for (std::size_t i = 0; i < count; ++i) {
+    touch(dir + "/f" + std::to_string(i));
+  }
+}
+
+/// One directory holding every entry
+void build_wide(const std::string& root, std::size_t entries) {
+  make_directory(root);
+  make_files(root, entries);
+}
+
+/// A chain of directories, each holding a few files
+void build_deep(const std::string& root, std::size_t entries) {
+  auto per_level = std::max<std::size_t>(1u, entries / deepest);
+  make_directory(root);
+  std::string dir = root;
+  for (std::size_t made = 0; made < entries; made += per_level + 1u) {
+    make_files(dir, per_level);
+    dir += "/d";
+    make_directory(dir);
+  }
+}
+
+/// Directories of files and subdirectories, filled breadth-first
+void build_mixed(const std::string& root, std::size_t entries) {
+  make_directory(root);
+  std::vector<std::string> level{root};
+  std::size_t made = 0u;
+  while (made < entries) {
+    std::vector<std::string> next;
+    for (auto& dir : level) {
+      if (made >= entries) break;
+      auto files = std::min(files_per_directory, entries - made);
+      make_files(dir, files);
+      made += files;
+      for (std::size_t i = 0; i < fan_out and made < entries; ++i, ++made) {
+        next.push_back(dir + "/d" + std::to_string(i));
+        make_directory(next.back());
+      }
+    }
+    level.swap(next);
+  }
+}
+
+///
+/// Drop cached directory contents before a cold walk
+///
+/// @return How the caches were dropped
+///
+const char * drop_caches(const std::string& root) {
+  ::sync();
+  {
+    std::ofstream control("/proc/sys/vm/drop_caches");
+    if (control and (control << "3\n") and control.flush()) {
+      return "drop_caches";
+    }
+  }
+  recursive_directory_sequence rds(root, dir_order::pre, visit_type::directory);
+  auto advise = [](const std::string& path) {
+    wrap::file_descriptor fd(::open(path.c_str(), O_RDONLY|O_DIRECTORY));
+    if (fd.valid()) ::posix_fadvise(fd.get(), 0, 0, POSIX_FADV_DONTNEED);
+  };
+  advise(root);
+  for (auto i = rds.begin(); i != rds.end(); ++i) {
+    advise(std::string(rds.full_path()));
+  }
+  return "posix_fadvise";
+}
+
+walk_type sequential(dir_order order, visit_type visit,
+    arr::directory_reader reader) {
+  return [=](const std::string& root) {
+    arr::directory_options options;
+    options.reader = reader;
+    recursive_directory_sequence rds(root, order, visit, options);
+    std::size_t count = 0u;
+    for (auto i = rds.begin(); i != rds.end(); ++i) ++count;
+    return count;
+  };
+}
+
+walk_type parallel(unsigned threads) {
+  return [=](const std::string& root) {
+    arr::directory_options options;
+    options.reader = arr::directory_reader::bulk;
+    arr::parallel_directory_traversal pdt(root, threads, visit_type::all,
+        options);
+    std::atomic<std::size_t> count {0u};
+    pdt.run([&](const arr::parallel_directory_entry&) {
+      count.fetch_add(1u, std::memory_order::relaxed);
+    });
+    return count.load();
+  };
+}
+
+walk_type prefetch() {
+  return [](const std::string& root) {
+    arr::directory_options options;
+    options.reader = arr::directory_reader::bulk;
+    arr::prefetch_traversal pt(root, 1024u, dir_order::pre, visit_type::all,
+        options);
+    std::size_t count = 0u;
+    for (auto i = pt.begin(); i != pt.end(); ++i) ++count;
+    return count;
+  };
+}
+
+struct walk {
+  const char * name;
+  walk_type run;
+};
+
+///
+/// Time a walk
+///
+/// Warm walks are repeated and the fastest is reported; a cold walk is run
+/// once after dropping caches.
+///
+void time_walk(const walk& w, const std::string& root, bool cold) {
+  using clock = std::chrono::steady_clock;
+  std::chrono::duration<double> best {0};
+  std::size_t count = 0u;
+  const char * how = nullptr;
+  for (int repeat = 0; repeat < (cold ? 1 : 3); ++repeat) {
+    if (cold) how = drop_caches(root);
+    auto start = clock::now();
+    count = w.run(root);
+    std::chrono::duration<double> elapsed = clock::now() - start;
+    if (0 == repeat or elapsed < best) best = elapsed;
+  }
+  std::cout << "  " << std::left << std::setw(28) << w.name << std::right
+    << std::setw(9) << count << " entries "
+    << std::fixed << std::setprecision(4) << best.count() << " s "
+    << std::setprecision(2) << double(count) / best.count() / 1e6
+    << " Mentries/s";
+  if (how) std::cout << " (" << how << ')';
+  std::cout << '\n';
+}
+
+}
+
+int main(int argc, char * argv[]) {
+  std::size_t entries = argc > 1 ? std::strtoul(argv[1], nullptr, 0) : 100000u;
+  bool cold = argc > 2 and 0 == std::strcmp(argv[2], "cold");
+  auto hw = std::max(1u, std::thread::hardware_concurrency());
+  using arr::directory_reader;
+  const std::vector<walk> walks{
+    {"pre all readdir",    sequential(dir_order::pre, visit_type::all,
+                             directory_reader::readdir)},
+    {"pre all bulk",       sequential(dir_order::pre, visit_type::all,
+                             directory_reader::bulk)},
+    {"post all bulk",      sequential(dir_order::post, visit_type::all,
+                             directory_reader::bulk)},
+    {"breadth all bulk",   sequential(dir_order::breadth, visit_type::all,
+                             directory_reader::bulk)},
+    {"pre file bulk",      sequential(dir_order::pre, visit_type::file,
+                             directory_reader::bulk)},
+    {"pre directory bulk", sequential(dir_order::pre, visit_type::directory,
+                             directory_reader::bulk)},
+    {"parallel 1 thread",  parallel(1u)},
+    {"parallel all threads", parallel(hw)},
+    {"prefetch",           prefetch()},
+  };
+  const std::vector<std::pair<const char *,
+        void (*)(const std::string&, std::size_t)>> shapes{
+    {"wide",  build_wide},
+    {"deep",  build_deep},
+    {"mixed", build_mixed},
+  };
+  std::cout << "entries " << entries << ", hardware threads " << hw
+    << (cold ? ", cold" : ", warm") << '\n';
+  arr::temp_dir dir(arr::removal::parallel);
+  for (auto& [name, build] : shapes) {
+    auto root = std::string(dir.name()) + '/' + name;
+    build(root, entries);
+    std::cout << name << '\n';
+    for (auto& w : walks) time_walk(w, root, cold);
+  }
+  return EXIT_SUCCESS;
+}
@@ -1,5 +1,5 @@
 //
-// Copyright (c) 2012, 2014, 2021
+// Copyright (c) 2012, 2014, 2021, 2026
 // Kyle Markley.  All rights reserved.
 //
 // Redistribution and use in source and binary forms, with or without
@@ -116,17 +116,39 @@ void access(arr::source_context context, const char * path, int amode) {
   if (0 != r) throw arr::path_exception(context, __func__, path);
 }
 
+size_t read(arr::source_context context, int d, void *buf, size_t nbytes) {
+  auto r = ::read(d, buf, nbytes);
+  if (-1 == r) throw arr::syscall_exception(context, __func__);
+  return size_t(r);
+}
+
 size_t write(arr::source_context context, int d, const void *buf, size_t nbytes) {
   auto r = ::write(d, buf, nbytes);
   if (-1 == r) throw arr::syscall_exception(context, __func__);
   return size_t(r);
 }
 
+void ftruncate(arr::source_context context, int fd, off_t length) {
+  auto r = ::ftruncate(fd, length);
+  if (0 != r) throw arr::syscall_exception(context, __func__);
+}
+
+void fsync(arr::source_context context, int fd) {
+  auto r = ::fsync(fd);
+  if (0 != r) throw arr::syscall_exception(context, __func__);
+}
+
 void unlink(arr::source_context context, const char * path) {
   auto r = ::unlink(path);
   if (0 != r) throw arr::path_exception(context, __func__, path);
 }
 
+void unlinkat(arr::source_context context,
+    int fd, const char * path, int flag) {
+  auto r = ::unlinkat(fd, path, flag);
+  if (0 != r) throw arr::path_exception(context, __func__, path);
+}
+
 void rmdir(arr::source_context context, const char * path) {
   auto r = ::rmdir(path);
   if (0 != r) throw arr::path_exception(context, __func__, path);
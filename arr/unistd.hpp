@@ -1,7 +1,7 @@
 #ifndef WRAP_UNISTD_HPP
 #define WRAP_UNISTD_HPP
 //
-// Copyright (c) 2012, 2014, 2021
+// Copyright (c) 2012, 2014, 2021, 2026
 // Kyle Markley.  All rights reserved.
 //
 // Redistribution and use in source and binary forms, with or without
@@ -116,16 +116,36 @@ extern std::chrono::microseconds fork_retry_delay;
 ///
 void access(arr::source_context, const char * path, int amode);
 
+///
+/// Wrapper for read(2)
+///
+size_t read(arr::source_context, int d, void *buf, size_t nbytes);
+
 ///
 /// Wrapper for write(2)
 ///
 size_t write(arr::source_context, int d, const void *buf, size_t nbytes);
 
+///
+/// Wrapper for ftruncate(2)
+///
+void ftruncate(arr::source_context, int fd, off_t length);
+
+///
+/// Wrapper for fsync(2)
+///
+void fsync(arr::source_context, int fd);
+
 ///
 /// Wrapper for unlink(2)
 ///
 void unlink(arr::source_context, const char *path);
 
+///
+/// Wrapper for unlinkat(2)
+///
+void unlinkat(arr::source_context, int fd, const char *path, int flag);
+
 ///
 /// Wrapper for rmdir(2)
 ///
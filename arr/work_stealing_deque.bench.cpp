@@ -0,0 +1,140 @@
+//
+// Copyright (c) 2026
+// Kyle Markley.  All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+// 3. Neither the name of the author nor the names of any contributors may be
+//    used to endorse or promote products derived from this software without
+//    specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+//
+// Benchmark of work_stealing_deque against a mutex-protected std::deque.
+//
+// One owner thread pushes tasks and pops them back, as a task scheduler does
+// for its local work, while thief threads steal from the other end.
+//
+
+#include "arr/work_stealing_deque.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using task = std::size_t;
+
+struct locked_deque {
+  void push(task t) {
+    std::lock_guard<std::mutex> lock(mutex);
+    data.push_back(t);
+  }
+  std::optional<task> pop() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (data.empty()) return std::nullopt;
+    auto t = data.back();
+    data.pop_back();
+    return t;
+  }
+  std::optional<task> steal() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (data.empty()) return std::nullopt;
+    auto t = data.front();
+    data.pop_front();
+    return t;
+  }
+  std::mutex mutex;
+  std::deque<task> data;
+};
+
+struct result {
+  std::chrono::duration<double> elapsed;
+  std::size_t stolen;
+};
+
+template <typename D>
+result run(std::size_t tasks, std::size_t burst, unsigned thieves) {
+  D deque;
+  std::atomic<std::size_t> done(0u);
+  std::atomic<std::size_t> stolen(0u);
+  std::atomic<bool> stop(false);
+  std::vector<std::thread> threads;
+  for (unsigned i = 0; i < thieves; ++i) {
+    threads.emplace_back([&] {
+      while (not stop.load(std::memory_order::relaxed)) {
+        if (deque.steal()) {
+          stolen.fetch_add(1u, std::memory_order::relaxed);
+          done.fetch_add(1u, std::memory_order::relaxed);
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+  auto start = std::chrono::steady_clock::now();
+  std::size_t pushed = 0u;
+  while (pushed < tasks) {
+    for (std::size_t i = 0; i < burst and pushed < tasks; ++i) {
+      deque.push(pushed++);
+    }
+    for (std::size_t i = 0; i < burst / 2u; ++i) {
+      if (deque.pop()) done.fetch_add(1u, std::memory_order::relaxed);
+    }
+  }
+  while (deque.pop()) done.fetch_add(1u, std::memory_order::relaxed);
+  while (done.load() < tasks) std::this_thread::yield();
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  stop = true;
+  for (auto& t : threads) t.join();
+  return { elapsed, stolen.load() };
+}
+
+void report(const char * name, std::size_t tasks, const result& r) {
+  std::cout << name
+    << ' ' << r.elapsed.count() << " s"
+    << ' ' << double(tasks) / r.elapsed.count() / 1e6 << " Mtasks/s"
+    << ' ' << r.stolen << " stolen\n";
+}
+
+}
+
+int main(int argc, char * argv[]) {
+  std::size_t tasks = argc > 1 ? std::strtoul(argv[1], nullptr, 0) : 10000000u;
+  std::size_t burst = 64u;
+  auto hw = std::thread::hardware_concurrency();
+  std::cout << "tasks " << tasks << ", burst " << burst
+    << ", hardware threads " << hw << '\n';
+  for (unsigned thieves : {0u, 1u, 3u, 7u}) {
+    std::cout << "thieves " << thieves << '\n';
+    report("  work_stealing_deque", tasks,
+        run<arr::work_stealing_deque<task>>(tasks, burst, thieves));
+    report("  mutex std::deque   ", tasks,
+        run<locked_deque>(tasks, burst, thieves));
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,229 @@
+#ifndef ARR_WORK_STEALING_DEQUE_HPP
+#define ARR_WORK_STEALING_DEQUE_HPP
+//
+// Copyright (c) 2026
+// Kyle Markley.  All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+// 3. Neither the name of the author nor the names of any contributors may be
+//    used to endorse or promote products derived from this software without
+//    specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include "arr/buffer_base.hpp"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+namespace arr {
+
+///
+/// \ingroup buffers
+/// Growable work-stealing deque
+///
+/// This is the deque of Chase and Lev ("Dynamic Circular Work-Stealing
+/// Deque", SPAA 2005), with the memory orderings of Le et al. ("Correct and
+/// Efficient Work-Stealing for Weak Memory Models", PPoPP 2013).
+///
+/// \par Concurrency
+///
+/// One owner thread may \c push and \c pop at the bottom of the deque.  Any
+/// number of thief threads may concurrently \c steal from the top.  Owner
+/// operations are lock-free and, except when stealing races for the last
+/// element, free of atomic read-modify-write operations.
+///
+/// \par Storage
+///
+/// Elements live in a power-of-two ring allocated as a \c buffer_base.  When
+/// the owner finds the ring full it allocates one twice as large.  Thieves
+/// may still be reading the old ring, so it is retired rather than freed, and
+/// released with the deque.  Retired rings total less than the current ring.
+///
+/// Elements are read speculatively by thieves, so they must be trivially
+/// copyable; a typical element is a pointer to a task.
+///
+template <typename T, unsigned align = 64u,
+         typename A = std::allocator<T>>
+struct work_stealing_deque {
+  static_assert(std::is_trivially_copyable<T>::value,
+      "work_stealing_deque elements must be trivially copyable");
+  using value_type = T;
+  using allocator_type = A;
+  using index_type = std::int64_t;
+  using size_type  = std::size_t;
+  using enum std::memory_order;
+
+  ///
+  /// Construct a work_stealing_deque
+  ///
+  /// @param count Initial capacity, rounded up to a power of two
+  /// @param alloc Allocator to use for storage
+  ///
+  explicit work_stealing_deque(
+      size_type count = 64u,
+      const allocator_type& alloc = allocator_type())
+    : _allocator(alloc)
+  {
+    size_type capacity = 1u;
+    while (capacity < count) capacity *= 2u;
+    _rings.emplace_back(new ring(capacity, _allocator));
+    _ring.store(_rings.back().get(), relaxed);
+  }
+
+  work_stealing_deque(const work_stealing_deque& ) = delete;
+  work_stealing_deque(      work_stealing_deque&&) = delete;
+  work_stealing_deque& operator=(const work_stealing_deque& ) = delete;
+  work_stealing_deque& operator=(      work_stealing_deque&&) = delete;
+
+  /// Returns the associated allocator
+  allocator_type get_allocator() const { return _allocator; }
+
+  ///
+  /// Number of elements
+  ///
+  /// This is exact only when observed by the owner with no concurrent thief.
+  ///
+  size_type size() const noexcept {
+    auto b = _bottom.load(relaxed);
+    auto t = _top.load(relaxed);
+    return b > t ? static_cast<size_type>(b - t) : 0u;
+  }
+  bool empty() const noexcept { return 0u == size(); }
+
+  /// Number of elements that fit before the owner must grow the ring
+  size_type capacity() const noexcept {
+    return _ring.load(relaxed)->capacity();
+  }
+
+  ///
+  /// Push an element onto the bottom, as the owner
+  ///
+  void push(const value_type& value) {
+    auto b = _bottom.load(relaxed);
+    auto t = _top.load(acquire);
+    auto r = _ring.load(relaxed);
+    if (b - t > static_cast<index_type>(r->capacity()) - 1) {
+      r = grow(r, t, b);
+    }
+    r->put(b, value);
+    std::atomic_thread_fence(release);
+    _bottom.store(b + 1, relaxed);
+  }
+
+  ///
+  /// Pop an element from the bottom, as the owner
+  ///
+  /// @return The most recently pushed element, or nothing if empty
+  ///
+  std::optional<value_type> pop() noexcept {
+    auto b = _bottom.load(relaxed) - 1;
+    auto r = _ring.load(relaxed);
+    _bottom.store(b, relaxed);
+    std::atomic_thread_fence(seq_cst);
+    auto t = _top.load(relaxed);
+    std::optional<value_type> result;
+    if (t <= b) {
+      result = r->get(b);
+      if (t == b) {
+        // Last element: race against thieves for it
+        if (not _top.compare_exchange_strong(t, t + 1, seq_cst, relaxed)) {
+          result.reset();
+        }
+        _bottom.store(b + 1, relaxed);
+      }
+    } else {
+      _bottom.store(b + 1, relaxed);
+    }
+    return result;
+  }
+
+  ///
+  /// Steal an element from the top, from any thread
+  ///
+  /// @return The least recently pushed element, or nothing
+  ///
+  /// Nothing is returned if the deque is empty or if another thread won a
+  /// race for the element; the caller may retry.
+  ///
+  std::optional<value_type> steal() noexcept {
+    auto t = _top.load(acquire);
+    std::atomic_thread_fence(seq_cst);
+    auto b = _bottom.load(acquire);
+    if (t < b) {
+      auto value = _ring.load(acquire)->get(t);
+      if (_top.compare_exchange_strong(t, t + 1, seq_cst, relaxed)) {
+        return value;
+      }
+    }
+    return std::nullopt;
+  }
+
+private:
+
+  using element = std::atomic<value_type>;
+  using element_allocator =
+    typename std::allocator_traits<A>::template rebind_alloc<element>;
+
+  /// Circular array of elements
+  struct ring : buffer_base<element, element_allocator> {
+    using base = buffer_base<element, element_allocator>;
+    ring(size_type count, const allocator_type& alloc)
+      : base(count, element_allocator(alloc))
+      , mask(count - 1u)
+    {
+      for (size_type i = 0; i < count; ++i) {
+        base::allocator_traits::construct(
+            base::allocator, base::elements + i, value_type());
+      }
+    }
+    element& at(index_type i) const noexcept {
+      return base::elements[static_cast<size_type>(i) & mask];
+    }
+    value_type get(index_type i) const noexcept { return at(i).load(relaxed); }
+    void put(index_type i, const value_type& v) noexcept {
+      at(i).store(v, relaxed);
+    }
+    const size_type mask;
+  };
+
+  /// Replace a full ring with one twice as large, as the owner
+  ring * grow(ring * old, index_type t, index_type b) {
+    _rings.emplace_back(new ring(2u * old->capacity(), _allocator));
+    auto r = _rings.back().get();
+    for (auto i = t; i < b; ++i) r->put(i, old->get(i));
+    _ring.store(r, release);
+    return r;
+  }
+
+  allocator_type _allocator;
+  std::vector<std::unique_ptr<ring>> _rings; ///< Current and retired rings
+  alignas(align) std::atomic<index_type> _top {0};
+  alignas(align) std::atomic<index_type> _bottom {0};
+  alignas(align) std::atomic<ring *> _ring {nullptr};
+};
+
+}
+
+#endif
@@ -0,0 +1,141 @@
+//
+// Copyright (c) 2026
+// Kyle Markley.  All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+// 3. Neither the name of the author nor the names of any contributors may be
+//    used to endorse or promote products derived from this software without
+//    specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include "arrtest/arrtest.hpp"
+#include "arr/work_stealing_deque.hpp"
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+UNIT_TEST_MAIN
+
+using namespace arr;
+using namespace std;
+
+SUITE(owner) {
+
+  TEST(empty) {
+    work_stealing_deque<int> d;
+    CHECK_EQUAL(true, d.empty());
+    CHECK_EQUAL(false, d.pop().has_value());
+    CHECK_EQUAL(false, d.steal().has_value());
+  }
+
+  TEST(capacity_rounding) {
+    work_stealing_deque<int> d(5);
+    CHECK_EQUAL(8u, d.capacity());
+  }
+
+  TEST(lifo_pop) {
+    work_stealing_deque<int> d(4);
+    d.push(1);
+    d.push(2);
+    d.push(3);
+    CHECK_EQUAL(3u, d.size());
+    CHECK_EQUAL(3, d.pop().value());
+    CHECK_EQUAL(2, d.pop().value());
+    CHECK_EQUAL(1, d.pop().value());
+    CHECK_EQUAL(false, d.pop().has_value());
+    CHECK_EQUAL(true, d.empty());
+  }
+
+  TEST(fifo_steal) {
+    work_stealing_deque<int> d(4);
+    d.push(1);
+    d.push(2);
+    d.push(3);
+    CHECK_EQUAL(1, d.steal().value());
+    CHECK_EQUAL(3, d.pop().value());
+    CHECK_EQUAL(2, d.steal().value());
+    CHECK_EQUAL(false, d.steal().has_value());
+  }
+
+  TEST(grow) {
+    work_stealing_deque<int> d(2);
+    d.push(0);
+    CHECK_EQUAL(0, d.steal().value());  // Offset the ring before growing
+    for (int i = 1; i <= 100; ++i) d.push(i);
+    CHECK_EQUAL(100u, d.size());
+    CHECK_EQUAL(true, d.capacity() >= 100u);
+    CHECK_EQUAL(1, d.steal().value());
+    for (int i = 100; i >= 2; --i) CHECK_EQUAL(i, d.pop().value());
+    CHECK_EQUAL(true, d.empty());
+  }
+
+}
+
+SUITE(concurrent) {
+
+  TEST(every_element_once) {
+    const int total = 200000;
+    const unsigned thieves = 3u;
+    work_stealing_deque<int> d(16);
+    vector<atomic<unsigned>> seen(total);
+    atomic<bool> done(false);
+    atomic<int> taken(0);
+
+    auto thief = [&] {
+      while (not done.load()) {
+        if (auto v = d.steal()) {
+          ++seen[static_cast<size_t>(*v)];
+          ++taken;
+        } else {
+          this_thread::yield();
+        }
+      }
+    };
+    vector<thread> threads;
+    for (unsigned i = 0; i < thieves; ++i) threads.emplace_back(thief);
+
+    for (int i = 0; i < total; ++i) {
+      d.push(i);
+      if (i % 3 == 0) {
+        if (auto v = d.pop()) {
+          ++seen[static_cast<size_t>(*v)];
+          ++taken;
+        }
+      }
+    }
+    while (auto v = d.pop()) {
+      ++seen[static_cast<size_t>(*v)];
+      ++taken;
+    }
+    while (taken.load() < total) this_thread::yield();
+    done = true;
+    for (auto& t : threads) t.join();
+
+    CHECK_EQUAL(total, taken.load());
+    bool once = all_of(seen.begin(), seen.end(),
+        [](const atomic<unsigned>& n) { return 1u == n.load(); });
+    CHECK_EQUAL(true, once);
+  }
+
+}